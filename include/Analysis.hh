@@ -10,6 +10,8 @@
 #include <tools/histo/h1d>
 #include <tools/histo/h2d>
 
+class Run;
+
 
 #define DISALLOW_COPY_AND_ASSIGN(TypeName) \
   TypeName(const TypeName&);               \
@@ -20,20 +22,21 @@ class Analysis {
     ~Analysis();
 
     static Analysis* GetAnalysis();
+    // Energy group structure of the PrimEnergy histogram [MeV].
+    static const std::vector<G4double>& GetPrimaryEnergyEdges();
 
-    void Book(G4String);
+    // runInfo (setup and random stream) is the title of the RunInfo
+    // histogram and the header of the convergence file.
+    void Book(G4String, const G4String& runInfo = "");
     void EndOfRun();
 
     void OpenFile(const G4String& fname);
     void Save();
     void Close(G4bool reset = true);
 
-    void FillEDep1(G4double eDep);
-    void FillEDep2(G4double eDep);
-    void FillEDepTot(G4double eDep);
-    void FillPrimaryEne(G4double);
-    void FillPrimaryPos(G4double, G4double);
-    void CheckConvergence();
+    void WriteTallies(const Run*);
+    // note (e.g. why the run stopped) goes below the runInfo header.
+    void CheckConvergence(const Run*, G4double runTime, const G4String& note = "");
 
   private:
     Analysis();
@@ -44,7 +47,9 @@ class Analysis {
     G4int eDepHistTot;
     G4int primEneHist;
     G4int primPosHist;
+    G4int runInfoHist;
     G4String convergenceName;
+    G4String runInfo;
 };
 
 #endif
\ No newline at end of file
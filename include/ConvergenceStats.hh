@@ -0,0 +1,90 @@
+// Class definition for ConvergenceStats().
+// Created by agent on October 17, 2026.
+
+/// \file ConvergenceStats.hh
+/// \brief Definition of ConvergenceStats class.
+
+#ifndef ConvergenceStats_h
+#define ConvergenceStats_h 1
+
+#include "globals.hh"
+
+#include <ostream>
+#include <utility>
+#include <vector>
+
+// Streaming replacement for G4ConvergenceTester:
+// Only the power sums of the scores are kept, so memory does not grow with
+// the number of histories and two instances can be merged by adding them.
+// A snapshot of the sums is taken every time the local history count
+// doubles (starting at fFirstCheckpoint) to build the convergence history.
+
+class ConvergenceStats
+{
+  public:
+    ConvergenceStats(const G4String& name = "", G4double firstCheckpoint = 1000.);
+    ~ConvergenceStats();
+
+    // One call per history, zero scores included.
+    inline void AddScore(G4double x);
+    void Merge(const ConvergenceStats&);
+    void Reset();
+
+    // Contiguous blocks holding the whole state, in a fixed order, to send
+    // the statistics to another process. The history is padded with empty
+    // snapshots to kMaxSnapshots so the size is known to the receiver;
+    // Merge ignores the padding.
+    static const G4int kMaxSnapshots = 48;
+    void GetBlocks(std::vector<std::pair<G4double*, G4int> >& blocks);
+
+    G4double GetHistories() const { return fSum.n; }
+    G4double GetNonZeroHistories() const { return fSum.nonZero; }
+    // Sums of the scores and of their squares.
+    G4double GetSum() const { return fSum.s1; }
+    G4double GetSumSquares() const { return fSum.s2; }
+    G4double GetMean() const;
+    G4double GetRelativeError() const;
+    G4double GetVOV() const;
+    G4double GetFOM(G4double time) const;
+
+    void ShowResult(std::ostream&, G4double time) const;
+    void ShowHistory(std::ostream&, G4double time) const;
+
+  private:
+    struct Moments {
+      G4double n = 0.;
+      G4double nonZero = 0.;
+      G4double s1 = 0.;
+      G4double s2 = 0.;
+      G4double s3 = 0.;
+      G4double s4 = 0.;
+      void Add(const Moments& other);
+    };
+
+    static G4double Mean(const Moments&);
+    static G4double RelativeError(const Moments&);
+    static G4double VOV(const Moments&);
+    void Checkpoint();
+
+    G4String fName;
+    G4double fFirstCheckpoint;
+    G4double fNextCheckpoint;
+    Moments fSum;
+    std::vector<Moments> fHistory;
+};
+
+inline void ConvergenceStats::AddScore(G4double x)
+{
+  fSum.n += 1.;
+  if (x != 0.) {
+    G4double x2 = x*x;
+    fSum.nonZero += 1.;
+    fSum.s1 += x;
+    fSum.s2 += x2;
+    fSum.s3 += x2*x;
+    fSum.s4 += x2*x2;
+  }
+  if (fSum.n >= fNextCheckpoint) Checkpoint();
+}
+
+#endif
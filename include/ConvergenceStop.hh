@@ -0,0 +1,96 @@
+// Class definition for ConvergenceStop().
+// Created by agent on October 17, 2026.
+
+/// \file ConvergenceStop.hh
+/// \brief Definition of ConvergenceStop class.
+
+#ifndef ConvergenceStop_h
+#define ConvergenceStop_h 1
+
+#include "globals.hh"
+#include "G4Threading.hh"
+
+#include <atomic>
+#include <vector>
+
+class Run;
+class ConvergenceStopMessenger;
+
+// Convergence-driven end of a run:
+// A target is a range of one of the tallies (BF3EnergyDep1, BF3EnergyDep2,
+// BF3EnergyDepTot, PrimEnergy) and a relative error; the whole range of
+// BF3EnergyDepTot above a threshold is the total count rate. BF3Detected,
+// the weighted detections per history (see Run), has no range and is the
+// count rate that is left with importance splitting. Every thread
+// adds the sums of weights and squared weights it scored since its last
+// report to shared atomic sums every checkInterval events, then checks all
+// targets against them without locking. Once every target is met (and at
+// least minEvents events are done) a stop flag is raised, which every
+// thread sees at its next event and ends its event loop with a soft
+// AbortRun. The decision is printed and written to the -conv.txt file.
+// The error of a range is sqrt(sum w^2)/sum w, as for the design search.
+
+class ConvergenceStop
+{
+  public:
+    ~ConvergenceStop();
+
+    static ConvergenceStop* GetInstance();
+
+    // Progress of one thread since its last report, kept in its Run.
+    static const G4int kMaxTargets = 16;
+    struct Published {
+      G4double sumW[kMaxTargets] = {};
+      G4double sumW2[kMaxTargets] = {};
+      G4int events = 0;
+    };
+
+    G4bool AddTarget(const G4String& tally, G4double emin, G4double emax, G4double relError);
+    void ClearTargets() { fTargets.clear(); }
+    void SetCheckInterval(G4int n) { fCheckInterval = n; }
+    void SetMinEvents(G4double n) { fMinEvents = n; }
+    G4bool IsActive() const { return !fTargets.empty(); }
+
+    // Master, at the start of a run.
+    void BeginRun();
+    // Any thread, after every event of its Run.
+    inline void Update(const Run*, Published&);
+    // The stopping decision of the last run, on one line.
+    G4String GetDecision() const;
+
+  private:
+    ConvergenceStop();
+
+    struct Target {
+      G4String tally;
+      G4double emin;
+      G4double emax;
+      G4double relError;
+    };
+
+    void Report(const Run*, Published&);
+    void Stop() const;
+    static void AtomicAdd(std::atomic<G4double>&, G4double);
+
+    std::vector<Target> fTargets;
+    G4int fCheckInterval;
+    G4double fMinEvents;
+
+    std::atomic<G4bool> fStop;
+    std::atomic<G4double> fEvents;
+    std::atomic<G4double> fSumW[kMaxTargets];
+    std::atomic<G4double> fSumW2[kMaxTargets];
+    // Written once by the thread that raises the flag.
+    G4Mutex fDecisionMutex;
+    G4String fDecision;
+
+    ConvergenceStopMessenger* fMessenger;
+};
+
+inline void ConvergenceStop::Update(const Run* aRun, Published& published)
+{
+  if (++published.events >= fCheckInterval) Report(aRun, published);
+  if (fStop.load(std::memory_order_relaxed)) Stop();
+}
+
+#endif
@@ -0,0 +1,35 @@
+// Header file for ConvergenceStopMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file ConvergenceStopMessenger.hh
+/// \file Header file for ConvergenceStopMessenger class.
+
+#ifndef ConvergenceStopMessenger_h
+#define ConvergenceStopMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class ConvergenceStop;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADouble;
+class G4UIcmdWithoutParameter;
+
+class ConvergenceStopMessenger: public G4UImessenger
+{
+  public:
+    ConvergenceStopMessenger(ConvergenceStop*);
+    virtual ~ConvergenceStopMessenger();
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    ConvergenceStop* fStop;
+    G4UIdirectory* fStopDir;
+    G4UIcommand* fAddTarget;
+    G4UIcmdWithoutParameter* fClearTargets;
+    G4UIcmdWithAnInteger* fCheckInterval;
+    G4UIcmdWithADouble* fMinEvents;
+};
+#endif
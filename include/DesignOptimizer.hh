@@ -0,0 +1,111 @@
+// Class definition for DesignOptimizer().
+// Created by agent on October 17, 2026.
+
+/// \file DesignOptimizer.hh
+/// \brief Definition of DesignOptimizer class.
+
+#ifndef DesignOptimizer_h
+#define DesignOptimizer_h 1
+
+#include "globals.hh"
+
+#include <cmath>
+#include <vector>
+
+class Run;
+class DesignOptimizerMessenger;
+
+// Moderator design search:
+// The design space is the grid spanned by any number of scanned UI
+// commands (e.g. /BF3/det/tubeGap, /BF3/det/moderatorSize). All designs run
+// in rounds from one process: after each round the designs whose upper
+// bound is below the leader's lower bound (confidence standard deviations
+// each) are dropped, and all others, ties included, go on with reduction
+// times more events each. The events per round are capped at those of the
+// first round, so the survivors share a fixed round budget rather than
+// being cut by rank. The search stops when one design is left and its
+// error is below the target, when all survivors reach the target (a tie),
+// or when the event budget is used up. The objective is the weighted number
+// of counts above a pulse height threshold, for whatever source the macro
+// set up (e.g. bugle96.mac). With importance splitting there are no pulse
+// heights and the weighted captures in the gas are counted instead.
+//
+// Normalization:
+// Energy, cross-section and importance weights are carried by the counts,
+// so biased searches rank like analog ones (tested by xsbias-compare in
+// CMakeLists.txt). What the count is divided by is set with
+// /BF3/opt/normalization:
+// - history: counts per source neutron. Only comparable between designs
+//   if the source is the same for all of them. A volume source confined
+//   to AirSource is not: GPS rejects the points outside the shell, which
+//   follows the moderator, so every design gets its own source region.
+// - fluence (default): counts per unit fluence of an isotropic field,
+//   i.e. per history times A/4, A being the moderator surface of the
+//   design. Use it with /BF3/gun/source surface, which starts every
+//   history on the moderator surface (see PrimaryGeneratorAction).
+
+class DesignOptimizer
+{
+  public:
+    ~DesignOptimizer();
+
+    static DesignOptimizer* GetInstance();
+
+    // Values for a 3-vector command are given as x,y,z.
+    void AddScan(const G4String& command, const G4String& unit,
+                 const std::vector<G4String>& values);
+    void ClearScans();
+    void SetEventsFirstRound(G4int n) { fEventsFirstRound = n; }
+    void SetReduction(G4double eta) { fReduction = eta; }
+    void SetConfidence(G4double z) { fConfidence = z; }
+    void SetTargetError(G4double re) { fTargetError = re; }
+    void SetMaxEvents(G4double n) { fMaxEvents = n; }
+    void SetThreshold(G4double e) { fThreshold = e; }
+    void SetFileName(const G4String& name) { fFileName = name; }
+    void SetNormalization(const G4String& mode) { fNormalization = mode; }
+
+    void Start();
+    G4bool IsRunning() const { return fRunning; }
+    void RecordRun(const Run*);
+
+  private:
+    DesignOptimizer();
+
+    struct Scan {
+      G4String command;
+      G4String unit;
+      std::vector<G4String> values;
+    };
+
+    struct Design {
+      std::vector<size_t> index;  // value index per scan
+      G4double events = 0.;
+      G4double sumW = 0.;
+      G4double sumW2 = 0.;
+      G4double scale = 1.;        // cm2 per history for fluence normalization
+      G4int rounds = 0;
+      G4bool alive = true;
+      G4double Value() const { return (events > 0.) ? scale*sumW/events : 0.; }
+      G4double Error() const { return (events > 0.) ? scale*std::sqrt(sumW2)/events : 0.; }
+    };
+
+    void ApplyDesign(const Design&) const;
+    void WriteTable() const;
+
+    std::vector<Scan> fScans;
+    G4int fEventsFirstRound;
+    G4double fReduction;
+    G4double fConfidence;
+    G4double fTargetError;
+    G4double fMaxEvents;
+    G4double fThreshold;
+    G4String fFileName;
+    G4String fNormalization;
+
+    G4bool fRunning;
+    std::vector<Design> fDesigns;
+    Design* fCurrent;
+    DesignOptimizerMessenger* fMessenger;
+};
+
+#endif
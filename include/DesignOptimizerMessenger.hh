@@ -0,0 +1,44 @@
+// Header file for DesignOptimizerMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file DesignOptimizerMessenger.hh
+/// \file Header file for DesignOptimizerMessenger class.
+
+#ifndef DesignOptimizerMessenger_h
+#define DesignOptimizerMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class DesignOptimizer;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+class DesignOptimizerMessenger: public G4UImessenger
+{
+  public:
+    DesignOptimizerMessenger(DesignOptimizer*);
+    virtual ~DesignOptimizerMessenger();
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    DesignOptimizer* fOptimizer;
+    G4UIdirectory* fOptDir;
+    G4UIcommand* fScan;
+    G4UIcmdWithoutParameter* fClearScans;
+    G4UIcmdWithAnInteger* fEvents;
+    G4UIcmdWithADouble* fReduction;
+    G4UIcmdWithADouble* fConfidence;
+    G4UIcmdWithADouble* fTargetError;
+    G4UIcmdWithADouble* fMaxEvents;
+    G4UIcmdWithADoubleAndUnit* fThreshold;
+    G4UIcmdWithAString* fFileName;
+    G4UIcmdWithAString* fNormalization;
+    G4UIcmdWithoutParameter* fRun;
+};
+#endif
@@ -9,10 +9,15 @@
 
 #include "G4VUserDetectorConstruction.hh"
 #include "G4NistManager.hh"
+#include "G4ThreeVector.hh"
 #include "globals.hh"
 
+#include <map>
+#include <vector>
+
 class G4VPhysicalVolume;
 class G4LogicalVolume;
+class DetectorMessenger;
 
 // Define detector/world geomteries and materials.
 
@@ -25,8 +30,73 @@ class DetectorConstruction : public G4VUserDetectorConstruction
     virtual G4VPhysicalVolume* Construct();
     virtual void ConstructSDandField();
 
+    // Scale neutron capture/inelastic cross sections in the BF3 gas by
+    // factor (1 = analog). Must be set before initialization.
+    void SetCrossSectionBiasing(G4double factor) { fXSBiasFactor = factor; }
+
+    // Build the moderator from plain boxes and daughter volumes instead of
+    // Boolean solids. Same geometry, cheaper navigation.
+    void SetBooleanFree(G4bool flag);
+    G4bool GetBooleanFree() const { return fBooleanFree; }
+
+    // Run time design parameters; in Idle state the geometry ones trigger
+    // a geometry reinitialization before the next run (refused with
+    // importance biasing), the gas ones a new material in the gas volumes.
+    void SetTubeDiameter(G4double);
+    void SetTubeHeight(G4double);
+    void SetTubeGap(G4double);
+    void SetModeratorSize(const G4ThreeVector&);
+    void SetB10Enrichment(G4double);
+    void SetGasDensity(G4double);
+    void SetGasPressure(G4double);
+
+    // 0.5 cm of air around the 2 cm AirSource shell, 0.5 cm above and below.
+    G4ThreeVector GetWorldSize() const { return G4ThreeVector(fModX + 5.*CLHEP::cm, fModY + 5.*CLHEP::cm, fModZ + 1.*CLHEP::cm); }
+    // Per-region production cut, maximum charged step and minimum charged
+    // kinetic energy for the regions Gas, Shell, Moderator and AirSource.
+    // They apply at the next run; no reinitialization is needed.
+    G4bool SetRegionCut(const G4String& region, G4double cut);
+    G4bool SetRegionMaxStep(const G4String& region, G4double step);
+    G4bool SetRegionMinEkine(const G4String& region, G4double ekin);
+
+    G4ThreeVector GetModeratorSize() const { return G4ThreeVector(fModX, fModY, fModZ); }
+    G4double GetTubeDiameter() const { return fTubeDiam; }
+    G4double GetTubeHeight() const { return fTubeHeight; }
+    // Distance of each tube axis from the moderator centre along x.
+    G4double GetTubeOffset() const { return 0.5*fTubeDiam + fTubeGap; }
+    // Design, gas and region settings on one line, for the output metadata.
+    G4String GetSetupDescription() const;
+
   private:
     std::map<std::string, G4Material*> fmats;
+    struct RegionSettings {
+      G4double cut;
+      G4double maxStep;
+      G4double minEkine;
+    };
+    std::map<G4String, RegionSettings> fRegions;
+    G4double fTubeDiam, fTubeHeight, fTubeGap;
+    G4double fModX, fModY, fModZ;
+    G4double fB10Enrichment;
+    G4double fGasDensity;
+    G4double fGasPressure;
+    G4int fGasVersion;
+    G4Element* fElB10;
+    G4Element* fElB11;
+    G4Element* fElF;
+    G4double fXSBiasFactor;
+    G4bool fBooleanFree;
+    DetectorMessenger* fMessenger;
+
+    void BuildGasMaterial();
+    void SetupRegion(const G4String& name, const std::vector<G4LogicalVolume*>& volumes);
+    void ApplyRegionSettings(const G4String& name);
+    // The tubes have to fit in the moderator; reports why not.
+    G4bool DesignFits(G4double tubeDiam, G4double tubeHeight, G4double tubeGap,
+                      const G4ThreeVector& moderatorSize) const;
+    G4bool GeometryCanBeModified() const;
+    void GeometryHasBeenModified();
+    void GasHasBeenModified();
 
   public:
     void ConstructMaterials();
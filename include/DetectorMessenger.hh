@@ -0,0 +1,45 @@
+// Header file for DetectorMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file DetectorMessenger.hh
+/// \file Header file for DetectorMessenger class.
+
+#ifndef DetectorMessenger_h
+#define DetectorMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class DetectorConstruction;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWith3VectorAndUnit;
+class G4UIcommand;
+
+class DetectorMessenger: public G4UImessenger
+{
+  public:
+    DetectorMessenger(DetectorConstruction*);
+    virtual ~DetectorMessenger();
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    DetectorConstruction* fDetector;
+    G4UIdirectory* fDetDir;
+    G4UIcmdWithABool* fBooleanFree;
+    G4UIcmdWithADoubleAndUnit* fTubeDiam;
+    G4UIcmdWithADoubleAndUnit* fTubeHeight;
+    G4UIcmdWithADoubleAndUnit* fTubeGap;
+    G4UIcmdWith3VectorAndUnit* fModSize;
+    G4UIcmdWithADouble* fEnrichment;
+    G4UIcmdWithADoubleAndUnit* fGasDensity;
+    G4UIcmdWithADoubleAndUnit* fGasPressure;
+    G4UIcommand* fRegionCut;
+    G4UIcommand* fRegionMaxStep;
+    G4UIcommand* fRegionMinEkine;
+
+    G4UIcommand* MakeRegionCommand(const G4String& path, const G4String& unit);
+};
+#endif
@@ -0,0 +1,31 @@
+// Header file for ImportanceMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file ImportanceMessenger.hh
+/// \file Header file for ImportanceMessenger class.
+
+#ifndef ImportanceMessenger_h
+#define ImportanceMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class ImportanceWorld;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithADouble;
+
+class ImportanceMessenger: public G4UImessenger
+{
+  public:
+    ImportanceMessenger(ImportanceWorld*);
+    virtual ~ImportanceMessenger();
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    ImportanceWorld* fImportanceWorld;
+    G4UIdirectory* fImpDir;
+    G4UIcommand* fValue;
+    G4UIcmdWithADouble* fBase;
+};
+#endif
@@ -0,0 +1,51 @@
+// Class definition for ImportanceWorld().
+// Created by agent on October 17, 2026.
+
+/// \file ImportanceWorld.hh
+/// \brief Definition of ImportanceWorld class.
+
+#ifndef ImportanceWorld_h
+#define ImportanceWorld_h 1
+
+#include "G4VUserParallelWorld.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class DetectorConstruction;
+class G4VPhysicalVolume;
+class ImportanceMessenger;
+
+// Parallel world for geometry importance biasing:
+// Nested boxes ("layers") run from just outside the AirSource shell down to
+// a core box around both BF3 tubes, so the mass geometry is untouched.
+// Layer i has importance base^i; G4ImportanceProcess splits neutrons
+// entering a more important layer and plays Russian roulette with the ones
+// leaving it.
+
+class ImportanceWorld : public G4VUserParallelWorld
+{
+  public:
+    ImportanceWorld(const G4String& worldName, const DetectorConstruction*, G4int nLayers);
+    virtual ~ImportanceWorld();
+
+    virtual void Construct();
+
+    G4VPhysicalVolume* GetWorldVolume() { return fGhostWorld; }
+    // Fill the G4IStore; to be called on the master after initialization.
+    void CreateImportanceStore();
+
+    G4int GetNumberOfLayers() const { return fNLayers; }
+    void SetImportance(G4int layer, G4double importance);
+    void SetImportanceBase(G4double base);
+
+  private:
+    const DetectorConstruction* fDetector;
+    G4int fNLayers;
+    G4VPhysicalVolume* fGhostWorld;
+    std::vector<G4VPhysicalVolume*> fLayers;
+    std::vector<G4double> fImportances;
+    ImportanceMessenger* fMessenger;
+};
+
+#endif
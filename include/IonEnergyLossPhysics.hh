@@ -0,0 +1,31 @@
+// Class definition for IonEnergyLossPhysics().
+// Created by agent on October 17, 2026.
+
+/// \file IonEnergyLossPhysics.hh
+/// \brief Definition of the IonEnergyLossPhysics class
+
+#ifndef IonEnergyLossPhysics_h
+#define IonEnergyLossPhysics_h 1
+
+#include "globals.hh"
+#include "G4VPhysicsConstructor.hh"
+
+// Minimal electromagnetic physics for the BF3 response:
+// Ionisation and multiple scattering of the light charged products of
+// 10B(n,alpha)7Li, 3He(n,p)t and neutron recoils, so their energy is
+// deposited in the gas with the right range. Photons and electrons get no
+// interactions; the 478 keV gamma and capture gammas leave the detector
+// without depositing energy.
+
+class IonEnergyLossPhysics : public G4VPhysicsConstructor
+{
+  public:
+    IonEnergyLossPhysics(const G4String& name = "ionEnergyLoss");
+   ~IonEnergyLossPhysics();
+
+  public:
+    virtual void ConstructParticle() { };
+    virtual void ConstructProcess();
+};
+
+#endif
@@ -12,17 +12,45 @@
 #include "G4VModularPhysicsList.hh"
 #include "globals.hh"
 
+#include <vector>
+
+class G4VPhysicsConstructor;
+class PhysicsListMessenger;
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+// Modes:
+//  "qgsp"        - reference list, the constructors of QGSP_BIC_AllHP
+//                  plus G4ThermalNeutrons.
+//  "hadr03"      - the full list copied from example Hadr03.
+//  "bf3response" - only what the tube response needs: high precision
+//                  neutron transport with thermal scattering in the
+//                  polyethylene, energy loss of the ions in the gas and
+//                  decays.
+// The mode is set with -physics on the command line or /BF3/phys/list
+// before /run/initialize. Constructors registered from outside (main)
+// are kept, after the ones of the mode.
+
 class PhysicsList: public G4VModularPhysicsList
 {
 public:
-  PhysicsList();
+  PhysicsList(const G4String& mode = "hadr03");
  ~PhysicsList();
 
 public:
   virtual void ConstructParticle();
   virtual void SetCuts();
+
+  void SetMode(const G4String& mode);
+  const G4String& GetMode() const { return fMode; }
+
+private:
+  void RegisterMode(const G4String& mode);
+  void RegisterModePhysics(G4VPhysicsConstructor*);
+
+  G4String fMode;
+  std::vector<G4VPhysicsConstructor*> fModePhysics;
+  PhysicsListMessenger* fMessenger;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
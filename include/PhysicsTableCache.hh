@@ -0,0 +1,54 @@
+// Class definition for PhysicsTableCache().
+// Created by agent on October 17, 2026.
+
+/// \file PhysicsTableCache.hh
+/// \brief Definition of PhysicsTableCache class.
+
+#ifndef PhysicsTableCache_h
+#define PhysicsTableCache_h 1
+
+#include "globals.hh"
+#include "G4VStateDependent.hh"
+
+class G4VUserPhysicsList;
+
+// Physics table cache:
+// The physics tables the master builds for the first run are stored in a
+// directory with the Geant4 store/retrieve mechanism and read back by
+// later jobs. The tables depend on everything the macros may still change
+// (materials, region cuts, EM parameters), so the key is made when the
+// first run starts: Geant4 version, data sets, physics list and options,
+// EM parameters, the default and per-region production cuts and the full
+// material table. Every key has its own subdirectory, named by a hash of
+// the key, with the key file inside. A job stores its tables in a
+// temporary directory and renames it into place in one step, so readers
+// only ever see complete sets and nothing is removed or overwritten.
+// Geant4 itself also refuses tables whose material-cuts couples do not
+// match. The HP neutron data are read from G4NDL as before.
+
+class PhysicsTableCache : public G4VStateDependent
+{
+  public:
+    // Follows the state changes of the master from construction on.
+    PhysicsTableCache(const G4String& directory, const G4String& physicsSetup,
+                      G4VUserPhysicsList*);
+    virtual ~PhysicsTableCache();
+
+    virtual G4bool Notify(G4ApplicationState requestedState);
+
+  private:
+    G4String MakeKey() const;
+    void Lookup();
+    void Store();
+
+    G4String fDirectory;
+    G4String fPhysicsSetup;
+    G4VUserPhysicsList* fPhysicsList;
+    G4String fKey;
+    G4String fKeyDirectory;
+    // Waiting for the first run, first run set up, done.
+    enum { kWaiting, kFirstRun, kDone } fStage;
+    G4bool fRetrieved;
+};
+
+#endif
@@ -11,8 +11,29 @@
 #include "G4GeneralParticleSource.hh"
 #include "globals.hh"
 
+#include <atomic>
+#include <vector>
+
 class G4GeneralParticleSource;
 class G4Event;
+class PrimaryGeneratorMessenger;
+
+// Energy biasing:
+// The GPS still samples position, direction and energy; with biasing on,
+// the energy is replaced by one drawn from a biased histogram q and the
+// primary carries the weight p(E)/q(E), p being the GPS /gps/hist/point
+// spectrum. In "auto" mode q mixes p with a flat distribution over the
+// spectrum groups, in "user" mode q comes from /BF3/gun/biasPoint.
+//
+// Surface source:
+// With /BF3/gun/source surface the GPS position and direction are replaced
+// by a point drawn uniformly on the outer faces of the moderator and an
+// inward cosine-law direction. For an isotropic field of fluence F this is
+// exactly the current entering the moderator, N = F*A/4 with A the
+// moderator surface, so no history is spent outside of it. With a fixed
+// direction (ResponseSweep) the surface source becomes a parallel beam on
+// the faces turned towards it, each picked by its projected area, so N is
+// F times the projected area of the moderator along that direction.
 
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
@@ -23,9 +44,54 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
     virtual void GeneratePrimaries(G4Event* );
 
     const G4GeneralParticleSource* GetParticleGun() const { return fParticleGun; }
+
+    void SetSourceMode(const G4String& mode)
+      { fSourceMode = mode; fSurfaceSource = (mode == "surface"); }
+    void SetEnergyBiasing(const G4String& mode);
+    void SetBiasMixing(G4double fraction);
+    void AddBiasPoint(G4double energy, G4double weight);
+    void ClearBiasPoints();
+
+    // Energy and, unless the direction is zero, direction of flight of
+    // every primary, set by ResponseSweep between runs for all threads.
+    // The GPS itself is left alone; energy 0 turns this off.
+    static void SetFixedPrimary(G4double energy, const G4ThreeVector& direction)
+      { fFixedEnergy = energy; fFixedDirection = direction; }
+
+    // Whether the last /BF3/gun/source was "surface". Worker threads take
+    // the command at the start of their next run, so the master only sees
+    // it once a run with it has begun.
+    static G4bool UsesSurfaceSource() { return fSurfaceSource; }
+    // Moderator area seen by a parallel beam along the given direction.
+    static G4double ProjectedArea(const G4ThreeVector& direction);
   
   private:
+    struct Histogram {
+      std::vector<G4double> edges;
+      std::vector<G4double> density;
+      std::vector<G4double> cumulative;
+    };
+
+    void BuildBiasing();
+    void GenerateSurfacePoint(G4ThreeVector& position, G4ThreeVector& direction) const;
+    static void BuildHistogram(const std::vector<G4double>& points, const std::vector<G4double>& weights, Histogram&);
+    static G4double Density(const Histogram&, G4double energy);
+
     G4GeneralParticleSource* fParticleGun;
+    PrimaryGeneratorMessenger* fMessenger;
+
+    G4String fSourceMode;
+    G4String fBiasMode;
+    G4double fBiasMixing;
+    std::vector<G4double> fBiasPoints;
+    std::vector<G4double> fBiasWeights;
+    G4bool fBiasBuilt;
+    Histogram fSource;
+    Histogram fBiased;
+
+    static G4double fFixedEnergy;
+    static G4ThreeVector fFixedDirection;
+    static std::atomic<G4bool> fSurfaceSource;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,36 @@
+// Header file for PrimaryGeneratorMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file PrimaryGeneratorMessenger.hh
+/// \file Header file for PrimaryGeneratorMessenger class.
+
+#ifndef PrimaryGeneratorMessenger_h
+#define PrimaryGeneratorMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class PrimaryGeneratorAction;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithADouble;
+class G4UIcmdWithoutParameter;
+
+class PrimaryGeneratorMessenger: public G4UImessenger
+{
+  public:
+    PrimaryGeneratorMessenger(PrimaryGeneratorAction*);
+    virtual ~PrimaryGeneratorMessenger();
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    PrimaryGeneratorAction* fPrimaryGenerator;
+    G4UIdirectory* fGunDir;
+    G4UIcmdWithAString* fSourceMode;
+    G4UIcmdWithAString* fBiasMode;
+    G4UIcmdWithADouble* fBiasMixing;
+    G4UIcommand* fBiasPoint;
+    G4UIcmdWithoutParameter* fClearBias;
+};
+#endif
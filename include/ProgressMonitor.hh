@@ -0,0 +1,84 @@
+// Class definition for ProgressMonitor().
+// Created by agent on October 17, 2026.
+
+/// \file ProgressMonitor.hh
+/// \brief Definition of ProgressMonitor class.
+
+#ifndef ProgressMonitor_h
+#define ProgressMonitor_h 1
+
+#include "globals.hh"
+#include "G4Threading.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class G4Run;
+class ProgressMonitorMessenger;
+
+// Progress report of a run:
+// Every thread counts its events and detected events (a deposit in either
+// tube) in its own cache line, with relaxed atomic stores only, so the
+// event loop never locks or writes output. A timer thread on the master
+// reads the counters every interval and prints the progress, the event
+// and count rates (overall, since the last report and per thread), the
+// elapsed time and the estimated time left.
+
+class ProgressMonitor
+{
+  public:
+    ~ProgressMonitor();
+
+    static ProgressMonitor* GetInstance();
+
+    // Time between reports, 0 for none.
+    void SetInterval(G4double interval) { fInterval = interval; }
+
+    // Master, from the RunAction.
+    void BeginRun(const G4Run*);
+    void EndRun();
+    // Any thread, once per event.
+    inline void Count(G4bool detected);
+
+  private:
+    ProgressMonitor();
+
+    struct alignas(64) Slot {
+      std::atomic<std::int64_t> events{0};
+      std::atomic<std::int64_t> counts{0};
+    };
+
+    void Loop();
+    void Report(G4double elapsed, G4double sinceLast, std::int64_t* lastEvents) const;
+
+    G4double fInterval;
+    G4double fToProcess;
+    // Slot 0 is the master (sequential runs), slot i+1 worker thread i.
+    std::unique_ptr<Slot[]> fSlots;
+    size_t fNSlots;
+
+    std::thread fTimer;
+    std::mutex fMutex;
+    std::condition_variable fWakeUp;
+    G4bool fDone;
+
+    ProgressMonitorMessenger* fMessenger;
+};
+
+inline void ProgressMonitor::Count(G4bool detected)
+{
+  size_t i = G4Threading::G4GetThreadId() + 1;
+  if (i >= fNSlots) return;
+  // Only this thread writes its slot, no read-modify-write is needed.
+  Slot& slot = fSlots[i];
+  slot.events.store(slot.events.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  if (detected) {
+    slot.counts.store(slot.counts.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+}
+
+#endif
@@ -0,0 +1,27 @@
+// Header file for ProgressMonitorMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file ProgressMonitorMessenger.hh
+/// \file Header file for ProgressMonitorMessenger class.
+
+#ifndef ProgressMonitorMessenger_h
+#define ProgressMonitorMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class ProgressMonitor;
+class G4UIcmdWithADoubleAndUnit;
+
+class ProgressMonitorMessenger: public G4UImessenger
+{
+  public:
+    ProgressMonitorMessenger(ProgressMonitor*);
+    virtual ~ProgressMonitorMessenger();
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    ProgressMonitor* fMonitor;
+    G4UIcmdWithADoubleAndUnit* fInterval;
+};
+#endif
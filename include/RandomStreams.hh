@@ -0,0 +1,47 @@
+// Class definition for RandomStreams().
+// Created by agent on October 17, 2026.
+
+/// \file RandomStreams.hh
+/// \brief Definition of RandomStreams class.
+
+#ifndef RandomStreams_h
+#define RandomStreams_h 1
+
+#include "globals.hh"
+
+// Reproducible, non-overlapping random streams:
+// At the start of every run the master MixMax engine is seeded with
+// MixMaxRng::seed_uniquestream from (base seed, job index, MPI rank, run
+// ID, checkpoint generation). MixMax guarantees that different ID tuples
+// give independent streams, so SLURM array tasks that only differ by
+// their job index never share random numbers, and a run is reproduced by
+// giving the same base seed and job index again. The event seeds of the
+// worker threads are drawn from this engine by the run manager.
+
+class RandomStreams
+{
+  public:
+    ~RandomStreams();
+
+    static RandomStreams* GetInstance();
+
+    void SetBaseSeed(G4long seed) { fBaseSeed = seed; }
+    void SetJob(G4long job) { fJob = job; }
+    void SetRank(G4long rank) { fRank = rank; }
+
+    // Master, at the start of every run.
+    void SeedRun(G4int runID, G4int generation);
+    // The IDs of the current stream, recorded in the output files.
+    G4String GetStreamID() const;
+
+  private:
+    RandomStreams();
+
+    G4long fBaseSeed;
+    G4long fJob;
+    G4long fRank;
+    G4long fRun;
+    G4long fGeneration;
+};
+
+#endif
@@ -0,0 +1,73 @@
+// Class definition for ResponseSweep().
+// Created by agent on October 17, 2026.
+
+/// \file ResponseSweep.hh
+/// \brief Definition of ResponseSweep class.
+
+#ifndef ResponseSweep_h
+#define ResponseSweep_h 1
+
+#include "globals.hh"
+
+#include <fstream>
+#include <vector>
+
+class Run;
+class ResponseSweepMessenger;
+
+// Response matrix sweep:
+// Runs one beamOn per (energy, direction) cell from the master, so physics,
+// geometry and worker threads are set up once for the whole matrix. Only
+// the energy and direction of the primaries are fixed per cell, through
+// PrimaryGeneratorAction, so the GPS configuration of the macro is never
+// changed; its position distribution (e.g. the AirSource volume) is used.
+// With /BF3/gun/source surface the cells are instead started on the
+// moderator surface (a parallel beam for a fixed direction), and each cell
+// carries a comment naming the source geometry and the area A that turns
+// its efficiency into a response per unit fluence, R = efficiency*A.
+// The master RunAction hands every merged Run to RecordRun, which writes
+// the detection efficiency and pulse height spectrum of the cell.
+
+class ResponseSweep
+{
+  public:
+    ~ResponseSweep();
+
+    static ResponseSweep* GetInstance();
+
+    void AddEnergy(G4double energy);
+    void UseGroupEnergies();
+    void ClearEnergies();
+    void AddDirection(G4double theta, G4double phi);
+    void ClearDirections();
+    void SetEventsPerCell(G4int n) { fEventsPerCell = n; }
+    void SetFileName(const G4String& name) { fFileName = name; }
+
+    void Start();
+    G4bool IsRunning() const { return fRunning; }
+    void RecordRun(const Run*);
+
+  private:
+    ResponseSweep();
+
+    struct Cell {
+      G4double energy;
+      G4double eLow;
+      G4double eHigh;
+      G4double theta;
+      G4double phi;
+    };
+
+    std::vector<Cell> fEnergies;
+    std::vector<std::pair<G4double, G4double> > fDirections;
+    G4int fEventsPerCell;
+    G4String fFileName;
+
+    G4bool fRunning;
+    G4bool fKeepAngular;
+    Cell fCurrent;
+    std::ofstream fOutput;
+    ResponseSweepMessenger* fMessenger;
+};
+
+#endif
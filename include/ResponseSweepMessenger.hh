@@ -0,0 +1,40 @@
+// Header file for ResponseSweepMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file ResponseSweepMessenger.hh
+/// \file Header file for ResponseSweepMessenger class.
+
+#ifndef ResponseSweepMessenger_h
+#define ResponseSweepMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class ResponseSweep;
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+class ResponseSweepMessenger: public G4UImessenger
+{
+  public:
+    ResponseSweepMessenger(ResponseSweep*);
+    virtual ~ResponseSweepMessenger();
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    ResponseSweep* fSweep;
+    G4UIdirectory* fSweepDir;
+    G4UIcmdWithADoubleAndUnit* fAddEnergy;
+    G4UIcmdWithoutParameter* fGroupEnergies;
+    G4UIcmdWithoutParameter* fClearEnergies;
+    G4UIcommand* fAddDirection;
+    G4UIcmdWithoutParameter* fClearDirections;
+    G4UIcmdWithAnInteger* fEvents;
+    G4UIcmdWithAString* fFileName;
+    G4UIcmdWithoutParameter* fRun;
+};
+#endif
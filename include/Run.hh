@@ -8,10 +8,16 @@
 #define Run_h 1
 
 #include <G4Run.hh>
+#include "ConvergenceStats.hh"
+#include "ConvergenceStop.hh"
+#include "Tally.hh"
 
-//Dummy class to show how to use MPI merging of
-//user defined G4Run. The dummycounter it's a unique number among threads.
-//Merge actually sums the dummyCounter so for the global run that is  Sum(i, 0<i<Nt)
+#include <chrono>
+#include <ostream>
+
+// Run with the histogram tallies, convergence statistics and kill counters
+// of one thread. Merge adds them, across threads by the run manager and
+// across MPI ranks by RunMerger, which sends the blocks of GetBlocks.
 class Run : public G4Run {
 
     public:
@@ -20,7 +26,71 @@ class Run : public G4Run {
       void Merge(const G4Run*);
       void RecordEvent(const G4Event* anEvent);
 
+      const Tally1D& GetEDep1() const { return fEDep1; }
+      const Tally1D& GetEDep2() const { return fEDep2; }
+      const Tally1D& GetEDepTot() const { return fEDepTot; }
+      const Tally1D& GetPrimaryEne() const { return fPrimaryEne; }
+      const Tally2D& GetPrimaryPos() const { return fPrimaryPos; }
+      const ConvergenceStats& GetConvergence1() const { return fConv1; }
+      const ConvergenceStats& GetConvergence2() const { return fConv2; }
+      const ConvergenceStats& GetConvergenceTot() const { return fConvTot; }
+      // Weighted detections per history: a deposit in either tube, or with
+      // importance splitting the weighted 10B(n,alpha) captures in the gas.
+      const ConvergenceStats& GetDetected() const { return fDetected; }
+
+      // Tracks removed by the StackingAction and the neutron killer.
+      enum KillReason { kKillEM, kKillIon, kKillNeutronTime, kKillNeutronEnergy,
+                        kKillNeutronInFlight, kNKillReasons };
+      void CountKill(G4int reason, G4double ekin)
+        { fKilled[reason] += 1.; fKilledEnergy[reason] += ekin; }
+      G4double GetKilled(G4int reason) const { return fKilled[reason]; }
+      G4double GetKilledEnergy(G4int reason) const { return fKilledEnergy[reason]; }
+      void ShowKills(std::ostream&) const;
+
+      // Pulse height spectra need the deposits of one history. With
+      // importance splitting, branches of different weight share a tube
+      // and no single weight is right, so only the weighted mean deposits
+      // (convergence statistics) are scored, and detections are counted
+      // per track as captures in the gas; set from main().
+      static void SetPulseHeightTallies(G4bool on) { fPulseHeightTallies = on; }
+      static G4bool HasPulseHeightTallies() { return fPulseHeightTallies; }
+
+      // Histories of the run, for normalization. Unlike the G4int event
+      // count it includes the runs read from files (RunFile) and does not
+      // overflow for merged results.
+      G4double GetNumberOfHistories() const { return fConvTot.GetHistories(); }
+
+      // Contiguous blocks of all the run data, in a fixed order that only
+      // depends on the binning (see RunMerger).
+      void GetBlocks(std::vector<std::pair<G4double*, G4int> >& blocks);
+
     private:
+      void ScoreConvergence(G4double val1, G4double val2);
+
+      // Histogram tallies, binned as in Analysis::Book.
+      Tally1D fEDep1;
+      Tally1D fEDep2;
+      Tally1D fEDepTot;
+      Tally1D fPrimaryEne;
+      Tally2D fPrimaryPos;
+
+      // Convergence statistics of the per-event deposits, kept per thread
+      // so the event loop never has to lock.
+      ConvergenceStats fConv1;
+      ConvergenceStats fConv2;
+      ConvergenceStats fConvTot;
+      ConvergenceStats fDetected;
+
+      G4double fKilled[kNKillReasons];
+      G4double fKilledEnergy[kNKillReasons];
+
+      // Wall clock time of the next checkpoint (RunCheckpoint).
+      std::chrono::steady_clock::duration fCheckpointInterval;
+      std::chrono::steady_clock::time_point fNextCheckpoint;
+      // Sums last reported to ConvergenceStop.
+      ConvergenceStop::Published fStopPublished;
+
+      static G4bool fPulseHeightTallies;
 };
 
 #endif 
@@ -14,7 +14,7 @@
 #include "G4StatAnalysis.hh"
 #include "Analysis.hh"
 #include "G4SDManager.hh"
-#include "G4ConvergenceTester.hh"
+#include "G4Timer.hh"
 #include "RunActionMessenger.hh"
 #include <iostream>
 
@@ -37,6 +37,7 @@ class RunAction : public G4UserRunAction
   private:
     G4String outFileName;
     RunActionMessenger* fMessenger;
+    G4Timer fTimer;
 
 };
 
@@ -0,0 +1,78 @@
+// Class definition for RunCheckpoint().
+// Created by agent on October 17, 2026.
+
+/// \file RunCheckpoint.hh
+/// \brief Definition of RunCheckpoint class.
+
+#ifndef RunCheckpoint_h
+#define RunCheckpoint_h 1
+
+#include "globals.hh"
+
+class G4Run;
+class Run;
+class RunCheckpointMessenger;
+
+// Checkpoint/restart for runs longer than the batch time limit:
+// With a checkpoint directory set, every thread writes its Run (tallies,
+// convergence sums, kill counters, event count; see RunFile) to its own
+// file at a fixed wall clock interval, and the master keeps the requested
+// event count and the engine state of the run start in a state file. All
+// files are written to a temporary name and renamed, so an interrupted
+// write never leaves a broken checkpoint. /BF3/run/resume adds up the
+// files of the last run that match the current setup, stores the sum as
+// the base of the next generation and runs the missing events; the base
+// is merged into the result at the end of the run. The generation is part
+// of the random stream ID (RandomStreams), so the continued run does not
+// repeat the random numbers of the lost one. The events of every
+// generation are independent histories, so the merged result has the same
+// statistics as an uninterrupted run. Per-thread engine states are not
+// needed: the master seeds every event.
+
+class RunCheckpoint
+{
+  public:
+    ~RunCheckpoint();
+
+    static RunCheckpoint* GetInstance();
+
+    void SetDirectory(const G4String& dir) { fDirectory = dir; }
+    void SetInterval(G4double interval) { fInterval = interval; }
+    // Generation of the run about to start: 0 for a new run, one more
+    // for every resume.
+    G4int GetGeneration() const { return fResuming ? fGeneration : 0; }
+    // Wall clock time between checkpoints of a thread, 0 when off.
+    G4double GetInterval() const { return fDirectory.empty() ? 0. : fInterval; }
+
+    // Master, from the RunAction.
+    void BeginRun(const G4Run*);
+    // Adds the restored part of a resumed run.
+    void EndRun(Run*);
+    // Removes the checkpoints once the results are written.
+    void Clear() const;
+    // Master: continue the run saved in the checkpoint directory.
+    void Resume();
+    // Any thread: save the run of this thread.
+    void Write(const Run*) const;
+
+  private:
+    RunCheckpoint();
+
+    G4String FileName(const G4String& name) const;
+    G4String BaseFileName(G4int generation) const;
+    G4String ThreadFilePrefix(G4int generation) const;
+    void RemoveFiles(G4int generation) const;
+    void WriteState() const;
+    G4bool ReadState();
+
+    G4String fDirectory;
+    G4String fSetup;
+    G4double fInterval;
+    G4int fGeneration;
+    G4int fTotalEvents;
+    G4bool fResuming;
+    Run* fBase;
+    RunCheckpointMessenger* fMessenger;
+};
+
+#endif
@@ -0,0 +1,33 @@
+// Header file for RunCheckpointMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file RunCheckpointMessenger.hh
+/// \file Header file for RunCheckpointMessenger class.
+
+#ifndef RunCheckpointMessenger_h
+#define RunCheckpointMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class RunCheckpoint;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithoutParameter;
+
+class RunCheckpointMessenger: public G4UImessenger
+{
+  public:
+    RunCheckpointMessenger(RunCheckpoint*);
+    virtual ~RunCheckpointMessenger();
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    RunCheckpoint* fCheckpoint;
+    G4UIdirectory* fRunDir;
+    G4UIcmdWithAString* fDirectory;
+    G4UIcmdWithADoubleAndUnit* fInterval;
+    G4UIcmdWithoutParameter* fResume;
+};
+#endif
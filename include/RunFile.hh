@@ -0,0 +1,40 @@
+// Class definition for RunFile().
+// Created by agent on October 17, 2026.
+
+/// \file RunFile.hh
+/// \brief Definition of RunFile class.
+
+#ifndef RunFile_h
+#define RunFile_h 1
+
+#include "globals.hh"
+
+class Run;
+
+// Binary files of a Run:
+// A magic word, the header below, the event count and the blocks of
+// Run::GetBlocks as native doubles. They are used for the checkpoints and
+// for the -tally.dat file written next to every result, which bf3-merge
+// adds up. Files with a different binning are refused on reading.
+
+class RunFile
+{
+  public:
+    struct Header {
+      G4String setup;        // Geant4 version, physics options, detector design
+      G4String stream;       // random stream (RandomStreams)
+      G4double runTime = 0.; // wall clock time [s]
+    };
+
+    // Physics options of this job, set in main(); the list is added from
+    // the PhysicsList.
+    static void SetPhysicsSetup(const G4String&);
+    // Everything the results depend on besides the source, on one line.
+    static G4String GetSetup();
+
+    static G4bool Write(const G4String& fileName, const Run*, const Header&);
+    // Adds the saved run to the given one.
+    static G4bool Read(const G4String& fileName, Run*, Header&);
+};
+
+#endif
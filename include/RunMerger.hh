@@ -0,0 +1,41 @@
+// Class definition for RunMerger().
+// Created by agent on October 17, 2026.
+
+/// \file RunMerger.hh
+/// \brief Definition of RunMerger class.
+
+#ifndef RunMerger_h
+#define RunMerger_h 1
+
+#ifdef BF3_USE_MPI
+
+#include "G4VUserMPIrunMerger.hh"
+
+class Run;
+
+// Reduction of the master Run of every MPI rank onto rank 0:
+// All data blocks of the run (Run::GetBlocks) are sent as doubles. Their
+// sizes only depend on the binning, so the receiving side can register a
+// fresh Run before the message is unpacked. The event count is sent by
+// G4VUserMPIrunMerger itself.
+
+class RunMerger : public G4VUserMPIrunMerger
+{
+  public:
+    RunMerger(const Run* aRun);
+    virtual ~RunMerger();
+
+  protected:
+    virtual void Pack();
+    virtual G4Run* UnPack();
+
+  private:
+    const Run* fRun;
+    // Flushed and padded copy of the sent run, it has to live until the
+    // message is packed.
+    Run* fCopy;
+};
+
+#endif
+
+#endif
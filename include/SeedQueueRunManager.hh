@@ -0,0 +1,24 @@
+// Class definition for SeedQueueRunManager().
+// Created by agent on October 17, 2026.
+
+/// \file SeedQueueRunManager.hh
+/// \brief Definition of SeedQueueRunManager class.
+
+#ifndef SeedQueueRunManager_h
+#define SeedQueueRunManager_h 1
+
+#include "globals.hh"
+
+// Multi-threaded or task-based run manager with a settable seed queue:
+// The master fills the seeds of up to nSeedsMax events at a time (Geant4
+// default 10000) and refills the queue when the workers have used it up.
+
+template <class RunManager>
+class SeedQueueRunManager : public RunManager
+{
+  public:
+    void SetSeedQueueDepth(G4int nEvents) { this->nSeedsMax = nEvents; }
+    G4int GetSeedQueueDepth() const { return this->nSeedsMax; }
+};
+
+#endif
@@ -0,0 +1,59 @@
+// Class definition for StackingAction().
+// Created by agent on October 17, 2026.
+
+/// \file StackingAction.hh
+/// \brief Definition of StackingAction class
+
+#ifndef StackingAction_h
+#define StackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+
+class G4Material;
+class G4EmCalculator;
+class DetectorConstruction;
+class StackingMessenger;
+class Run;
+
+// Stacking Action:
+// Drops new tracks that cannot change the tube tallies. BF3SensitiveDetector
+// only scores neutrons and light ions, so photons, electrons and positrons
+// never add to a deposit and are killed on creation. Charged hadrons and
+// ions born outside the gas are killed when the gas is farther away than
+// their range in air, the least dense material of the setup. Neutrons can
+// be cut in time and energy; the same limits go to the nKiller process
+// for neutrons already in flight. Every kill is counted in the Run.
+
+class StackingAction : public G4UserStackingAction
+{
+  public:
+    StackingAction();
+    virtual ~StackingAction();
+
+    virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+    virtual void PrepareNewEvent();
+
+    void SetKillElectromagnetic(G4bool flag) { fKillEM = flag; }
+    void SetKillRemoteCharged(G4bool flag) { fKillRemote = flag; }
+    void SetNeutronTimeLimit(G4double);
+    void SetNeutronEnergyLimit(G4double);
+
+  private:
+    G4double DistanceToGas(const G4ThreeVector&) const;
+    void UpdateNeutronKiller() const;
+
+    G4bool fKillEM;
+    G4bool fKillRemote;
+    G4double fNeutronTimeLimit;
+    G4double fNeutronEnergyLimit;
+
+    const DetectorConstruction* fDetector;
+    const G4Material* fAir;
+    // One per thread, like the action itself.
+    G4EmCalculator* fCalculator;
+    Run* fRun;
+    StackingMessenger* fMessenger;
+};
+
+#endif
@@ -0,0 +1,33 @@
+// Header file for StackingMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file StackingMessenger.hh
+/// \file Header file for StackingMessenger class.
+
+#ifndef StackingMessenger_h
+#define StackingMessenger_h 1
+
+#include "globals.hh"
+#include "G4UImessenger.hh"
+
+class StackingAction;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+
+class StackingMessenger: public G4UImessenger
+{
+  public:
+    StackingMessenger(StackingAction*);
+    virtual ~StackingMessenger();
+    virtual void SetNewValue(G4UIcommand*, G4String);
+
+  private:
+    StackingAction* fStackingAction;
+    G4UIdirectory* fStackDir;
+    G4UIcmdWithABool* fKillEM;
+    G4UIcmdWithABool* fKillRemote;
+    G4UIcmdWithADoubleAndUnit* fTimeLimit;
+    G4UIcmdWithADoubleAndUnit* fEnergyLimit;
+};
+#endif
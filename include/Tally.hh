@@ -0,0 +1,118 @@
+// Class definitions for Tally1D() and Tally2D().
+// Created by agent on October 17, 2026.
+
+/// \file Tally.hh
+/// \brief Definition of the Tally1D and Tally2D classes.
+
+#ifndef Tally_h
+#define Tally_h 1
+
+#include "globals.hh"
+
+#include <utility>
+#include <vector>
+
+namespace tools {
+namespace histo {
+  class h1d;
+  class h2d;
+}
+}
+
+// Plain per-thread histogram tallies:
+// Bin contents are kept in contiguous arrays with the same layout as
+// tools::histo (index 0 is the underflow, nbins+1 the overflow), so a Run
+// can own them, merge them by addition and hand them to the analysis
+// manager once at the end of the run. Tally1D buffers fills and bins them
+// in batches with a branch-free search, which the compiler can vectorize.
+
+class Tally1D
+{
+  public:
+    Tally1D(G4int nbins, G4double xmin, G4double xmax);
+    Tally1D(const std::vector<G4double>& edges);
+    ~Tally1D();
+
+    inline void Fill(G4double x, G4double w = 1.);
+    // Bin everything still buffered. Only the buffer is touched, the
+    // histogram content does not change, hence const.
+    void Flush() const;
+    void Merge(const Tally1D&);
+    void Reset();
+    // Contiguous blocks of the bin arrays, in a fixed order, to send the
+    // tally to another process. Flushes the buffer first.
+    void GetBlocks(std::vector<std::pair<G4double*, G4int> >& blocks);
+
+    G4int GetNbins() const { return fNbins; }
+    G4int FindBin(G4double x) const;
+    G4double GetEntries(G4int i) const { Flush(); return fEntries[i]; }
+    G4double GetSw(G4int i) const { Flush(); return fSw[i]; }
+    G4double GetSw2(G4int i) const { Flush(); return fSw2[i]; }
+    G4double GetSumW() const;
+
+    // Add the content to a histogram booked with the same binning.
+    void AddTo(tools::histo::h1d*) const;
+
+  private:
+    static const size_t kBatchSize = 256;
+
+    G4int fNbins;
+    G4bool fFixed;
+    G4double fXmin;
+    G4double fInvWidth;
+    // Bin edges padded with +max to a power of two for the search.
+    std::vector<G4double> fEdges;
+    size_t fSearchSize;
+
+    std::vector<G4double> fEntries;
+    std::vector<G4double> fSw;
+    std::vector<G4double> fSw2;
+    std::vector<G4double> fSxw;
+    std::vector<G4double> fSx2w;
+
+    mutable size_t fNPending;
+    mutable G4double fPendingX[kBatchSize];
+    mutable G4double fPendingW[kBatchSize];
+    mutable G4int fPendingBin[kBatchSize];
+};
+
+inline void Tally1D::Fill(G4double x, G4double w)
+{
+  fPendingX[fNPending] = x;
+  fPendingW[fNPending] = w;
+  if (++fNPending == kBatchSize) Flush();
+}
+
+//
+//
+
+class Tally2D
+{
+  public:
+    Tally2D(G4int nx, G4double xmin, G4double xmax, G4int ny, G4double ymin, G4double ymax);
+    ~Tally2D();
+
+    void Fill(G4double x, G4double y, G4double w = 1.);
+    void Merge(const Tally2D&);
+    void Reset();
+    void GetBlocks(std::vector<std::pair<G4double*, G4int> >& blocks);
+
+    void AddTo(tools::histo::h2d*) const;
+
+  private:
+    G4int Index(G4double v, G4double vmin, G4double invWidth, G4int n) const;
+
+    G4int fNx, fNy;
+    G4double fXmin, fYmin;
+    G4double fInvWidthX, fInvWidthY;
+
+    std::vector<G4double> fEntries;
+    std::vector<G4double> fSw;
+    std::vector<G4double> fSw2;
+    std::vector<G4double> fSxw;
+    std::vector<G4double> fSx2w;
+    std::vector<G4double> fSyw;
+    std::vector<G4double> fSy2w;
+};
+
+#endif
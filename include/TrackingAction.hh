@@ -0,0 +1,26 @@
+// Class definition for TrackingAction().
+// Created by agent on October 17, 2026.
+
+/// \file TrackingAction.hh
+/// \brief Definition of TrackingAction class
+
+#ifndef TrackingAction_h
+#define TrackingAction_h 1
+
+#include "G4UserTrackingAction.hh"
+#include "globals.hh"
+
+// Tracking Action:
+// Counts the neutrons stopped in flight by the nKiller process, so the
+// Run reports them next to the StackingAction kills.
+
+class TrackingAction : public G4UserTrackingAction
+{
+  public:
+    TrackingAction();
+    virtual ~TrackingAction();
+
+    virtual void PostUserTrackingAction(const G4Track*);
+};
+
+#endif
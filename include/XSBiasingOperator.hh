@@ -0,0 +1,48 @@
+// Class definition for XSBiasingOperator().
+// Created by agent on October 17, 2026.
+// Adapted from the Geant4 example GB01.
+
+/// \file XSBiasingOperator.hh
+/// \brief Definition of XSBiasingOperator class.
+
+#ifndef XSBiasingOperator_h
+#define XSBiasingOperator_h 1
+
+#include "G4VBiasingOperator.hh"
+#include "globals.hh"
+
+#include <map>
+
+class G4BOptnChangeCrossSection;
+class G4ParticleDefinition;
+
+// Cross-section biasing of neutron reactions in the BF3 gas:
+// Multiplies the cross section of every biased neutron process (see
+// main.cc) by fFactor in the logical volumes the operator is attached to.
+// The weight correction is done by G4BOptnChangeCrossSection.
+
+class XSBiasingOperator : public G4VBiasingOperator
+{
+  public:
+    XSBiasingOperator(const G4String& particleToBias, G4double factor, const G4String& name = "BF3XSBiasing");
+    virtual ~XSBiasingOperator();
+
+    virtual void StartRun();
+
+  private:
+    virtual G4VBiasingOperation* ProposeOccurenceBiasingOperation(const G4Track*, const G4BiasingProcessInterface*);
+    virtual G4VBiasingOperation* ProposeFinalStateBiasingOperation(const G4Track*, const G4BiasingProcessInterface*) { return 0; }
+    virtual G4VBiasingOperation* ProposeNonPhysicsBiasingOperation(const G4Track*, const G4BiasingProcessInterface*) { return 0; }
+
+    using G4VBiasingOperator::OperationApplied;
+    virtual void OperationApplied(const G4BiasingProcessInterface* callingProcess, G4BiasingAppliedCase,
+                                  G4VBiasingOperation* occurenceOperationApplied, G4double weightForOccurenceInteraction,
+                                  G4VBiasingOperation* finalStateOperationApplied, const G4VParticleChange* particleChangeProduced);
+
+    std::map<const G4BiasingProcessInterface*, G4BOptnChangeCrossSection*> fChangeCrossSectionOperations;
+    G4bool fSetup;
+    G4double fFactor;
+    const G4ParticleDefinition* fParticleToBias;
+};
+
+#endif
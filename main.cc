@@ -1,5 +1,7 @@
 
 #include "G4MTRunManager.hh"
+#include "G4TaskRunManager.hh"
+#include "G4Threading.hh"
 
 #include "G4RunManager.hh"
 
@@ -10,33 +12,197 @@
 #include "G4UIExecutive.hh"
 
 #include "ActionInitialization.hh"
+#include "SeedQueueRunManager.hh"
+#include "ResponseSweep.hh"
+#include "DesignOptimizer.hh"
+#include "RunCheckpoint.hh"
+#include "RandomStreams.hh"
+#include "RunFile.hh"
+#include "ConvergenceStop.hh"
+#include "Run.hh"
+#include "ProgressMonitor.hh"
 #include "DetectorConstruction.hh"
-#include "QGSP_BIC_AllHP.hh"
 #include "G4ParticleHPManager.hh"
 #include "globals.hh"
 #include "PhysicsList.hh"
-#include "G4ThermalNeutrons.hh"
+#include "ImportanceWorld.hh"
+#include "PhysicsTableCache.hh"
+#include "G4GeometrySampler.hh"
+#include "G4ImportanceBiasing.hh"
+#include "G4ParallelWorldPhysics.hh"
+#include "G4StepLimiterPhysics.hh"
+#include "G4NeutronTrackingCut.hh"
+#include "G4GenericBiasingPhysics.hh"
+
+#ifdef BF3_USE_MPI
+#include "G4MPImanager.hh"
+#include "G4MPIsession.hh"
+#endif
+
+#include <cfloat>
+#include <cstdlib>
+#include <sstream>
+#include <unistd.h>
+
+// Usage: bf3 [-runManager serial|mt|tasking] [-threads n] [-grain events]
+//            [-seedQueue events] [-physics qgsp|hadr03|bf3response]
+//            [-importance nLayers] [-xsbias factor] [-cache dir]
+//            [-seed base] [-job index] [macro]
+// Without a macro an interactive session is started. -job defaults to
+// SLURM_JOB_ID, else the process id, and -seed to the start time; both
+// are printed and written to the output files, so a run can be repeated
+// exactly.
+// Built with -DWITH_MPI=ON, run e.g. mpirun -np 4 bf3 -threads 16 mpi.mac;
+// every rank runs its share of /mpi/beamOn and rank 0 writes the results.
 int main(int argc, char** argv)
 {
+  G4String macroName = "";
+  G4String runManagerType = "mt";
+  G4int nThreads = 0;
+  G4int grain = 0;
+  G4int seedQueue = 0;
+  G4String physicsName = "qgsp";
+  G4String cacheDir = "";
+  G4int importanceLayers = 0;
+  G4double xsBiasFactor = 1.;
+  G4long baseSeed = time(NULL);
+  // Jobs started in the same second still get different streams; every
+  // task of an array job has its own SLURM_JOB_ID.
+  G4long job = getpid();
+  if (std::getenv("SLURM_JOB_ID")) job = std::atol(std::getenv("SLURM_JOB_ID"));
+  for (G4int i = 1; i < argc; i++) {
+    G4String arg = argv[i];
+    if (arg == "-runManager" && i + 1 < argc) {
+      runManagerType = argv[++i];
+    } else if (arg == "-threads" && i + 1 < argc) {
+      nThreads = std::atoi(argv[++i]);
+    } else if (arg == "-grain" && i + 1 < argc) {
+      grain = std::atoi(argv[++i]);
+    } else if (arg == "-seedQueue" && i + 1 < argc) {
+      seedQueue = std::atoi(argv[++i]);
+    } else if (arg == "-physics" && i + 1 < argc) {
+      physicsName = argv[++i];
+    } else if (arg == "-importance" && i + 1 < argc) {
+      importanceLayers = std::atoi(argv[++i]);
+    } else if (arg == "-xsbias" && i + 1 < argc) {
+      xsBiasFactor = std::atof(argv[++i]);
+    } else if (arg == "-cache" && i + 1 < argc) {
+      cacheDir = argv[++i];
+    } else if (arg == "-seed" && i + 1 < argc) {
+      baseSeed = std::atol(argv[++i]);
+    } else if (arg == "-job" && i + 1 < argc) {
+      job = std::atol(argv[++i]);
+    } else {
+      macroName = arg;
+    }
+  }
+
     G4UIExecutive* ui = 0;
-  if ( argc == 1 ){
+#ifndef BF3_USE_MPI
+  if ( macroName.empty() ){
     ui = new G4UIExecutive(argc, argv);
   }
+#endif
 
+  // The engine is seeded at the start of every run, see RandomStreams.
   G4Random::setTheEngine(new CLHEP::MixMaxRng);
-  G4Random::setTheSeed(time(NULL));
-  G4cout << "Seed " << G4Random::getTheSeed() << G4endl;
-  G4MTRunManager* runManager = new G4MTRunManager;
+  RandomStreams* streams = RandomStreams::GetInstance();
+  streams->SetBaseSeed(baseSeed);
+  streams->SetJob(job);
+#ifdef BF3_USE_MPI
+  // Our own options are not passed on. The seeds G4MPImanager hands out
+  // are replaced by the per-run streams, which include the rank.
+  G4MPImanager* g4MPI = new G4MPImanager();
+  G4MPIsession* session = g4MPI->GetMPIsession();
+  streams->SetRank(g4MPI->GetRank());
+  G4cout << "MPI rank " << g4MPI->GetRank() << " of " << g4MPI->GetSize() << G4endl;
+#endif
+  G4cout << "Seed " << baseSeed << ", job " << job << G4endl;
+  // Threads default to all logical cores; -grain is the number of events a
+  // worker takes per request (MT) or per task (tasking), auto if 0. Small
+  // grains balance better when event cost varies with primary energy.
+  G4RunManager* runManager = 0;
+  if (runManagerType == "serial") {
+    runManager = new G4RunManager;
+  } else if (runManagerType == "mt" || runManagerType == "tasking") {
+    G4MTRunManager* mtRunManager = 0;
+    if (runManagerType == "mt") {
+      SeedQueueRunManager<G4MTRunManager>* seeded = new SeedQueueRunManager<G4MTRunManager>;
+      if (seedQueue > 0) seeded->SetSeedQueueDepth(seedQueue);
+      mtRunManager = seeded;
+    } else {
+      SeedQueueRunManager<G4TaskRunManager>* seeded = new SeedQueueRunManager<G4TaskRunManager>;
+      if (seedQueue > 0) seeded->SetSeedQueueDepth(seedQueue);
+      mtRunManager = seeded;
+    }
+    mtRunManager->SetNumberOfThreads(nThreads > 0 ? nThreads : G4Threading::G4GetNumberOfCores());
+    if (grain > 0) mtRunManager->SetEventModulo(grain);
+    runManager = mtRunManager;
+  } else {
+    G4cerr << "Unknown run manager " << runManagerType << ", use serial, mt or tasking." << G4endl;
+    return 1;
+  }
+  G4cout << "Run manager: " << runManagerType << G4endl;
 
-  runManager->SetUserInitialization(new DetectorConstruction());
+  DetectorConstruction* detector = new DetectorConstruction();
+  detector->SetCrossSectionBiasing(xsBiasFactor);
+  runManager->SetUserInitialization(detector);
 
-  G4VModularPhysicsList* physicsList = new QGSP_BIC_AllHP();
-  physicsList->RegisterPhysics( new G4ThermalNeutrons());
-  //G4VModularPhysicsList* physicsList = new QGSP_BIC_AllHP();
+  // Optional importance biasing on a layered parallel world; the mass
+  // geometry and the unbiased path stay as they are.
+  ImportanceWorld* importanceWorld = 0;
+  G4GeometrySampler* importanceSampler = 0;
+  if (importanceLayers > 0) {
+    importanceWorld = new ImportanceWorld("ImportanceWorld", detector, importanceLayers);
+    detector->RegisterParallelWorld(importanceWorld);
+    // Split branches share the tubes; see Run::SetPulseHeightTallies.
+    Run::SetPulseHeightTallies(false);
+    G4cout << "Importance splitting: pulse height spectra are off, the mean"
+           << " deposits are weighted per deposit and BF3Detected counts the"
+           << " weighted 10B(n,alpha) captures in the gas." << G4endl;
+  }
+
+  // qgsp (reference), hadr03 or bf3response, see PhysicsList; init.mac
+  // can still change it with /BF3/phys/list.
+  PhysicsList* physicsList = new PhysicsList(physicsName);
+  G4cout << "Physics list: " << physicsName << G4endl;
+  // Outside the detector regions (see DetectorConstruction) only:
   physicsList->SetDefaultCutValue(700*CLHEP::um);
+  // Per-region step limits and minimum energies of charged particles.
+  physicsList->RegisterPhysics(new G4StepLimiterPhysics());
+  // nKiller process for the /BF3/stack/ neutron limits, off until set.
+  if (!physicsList->GetPhysics("neutronTrackingCut")) {
+    G4NeutronTrackingCut* neutronCut = new G4NeutronTrackingCut();
+    neutronCut->SetTimeLimit(DBL_MAX);
+    neutronCut->SetKineticEnergyLimit(0.);
+    physicsList->RegisterPhysics(neutronCut);
+  }
   physicsList->SetVerboseLevel(1);
+  if (importanceWorld) {
+    importanceSampler = new G4GeometrySampler(importanceWorld->GetWorldVolume(), "neutron");
+    importanceSampler->SetParallel(true);
+    physicsList->RegisterPhysics(new G4ImportanceBiasing(importanceSampler, "ImportanceWorld"));
+    physicsList->RegisterPhysics(new G4ParallelWorldPhysics("ImportanceWorld"));
+  }
+  if (xsBiasFactor != 1.) {
+    // 10B(n,alpha) is part of neutronInelastic in the HP models.
+    G4GenericBiasingPhysics* biasingPhysics = new G4GenericBiasingPhysics();
+    biasingPhysics->PhysicsBias("neutron", {"neutronInelastic", "nCapture"});
+    physicsList->RegisterPhysics(biasingPhysics);
+  }
   runManager->SetUserInitialization(physicsList);
   runManager->SetVerboseLevel(0);
+  // Recorded with every result (RunFile) and part of the table cache key;
+  // both add the list itself, which init.mac may still change.
+  std::ostringstream setup;
+  setup << "importance " << importanceLayers << " xsbias " << xsBiasFactor;
+  RunFile::SetPhysicsSetup(setup.str());
+  // Physics tables stored by an earlier job with the same setup; looked
+  // up when the first run starts, after the macros set everything up.
+  PhysicsTableCache* tableCache = 0;
+  if (!cacheDir.empty()) {
+    tableCache = new PhysicsTableCache(cacheDir, setup.str(), physicsList);
+  }
   G4ParticleHPManager::GetInstance()->SetSkipMissingIsotopes( false );
   G4ParticleHPManager::GetInstance()->SetDoNotAdjustFinalState( false );
   G4ParticleHPManager::GetInstance()->SetUseOnlyPhotoEvaporation( false );
@@ -46,25 +212,41 @@ int main(int argc, char** argv)
   G4ParticleHPManager::GetInstance()->SetUseNRESP71Model( false );
 
   runManager->SetUserInitialization(new ActionInitialization());
+  // Response matrix sweep, driven from the master with /BF3/sweep/ commands.
+  ResponseSweep* sweep = ResponseSweep::GetInstance();
+  // Design search, driven from the master with /BF3/opt/ commands.
+  DesignOptimizer* optimizer = DesignOptimizer::GetInstance();
+  // Checkpoint/restart, set up from the master with /BF3/run/ commands.
+  RunCheckpoint* checkpoint = RunCheckpoint::GetInstance();
+  // Convergence-driven end of runs, set up with /BF3/stop/ commands.
+  ConvergenceStop* convergenceStop = ConvergenceStop::GetInstance();
+  // Progress reports during runs, set with /BF3/run/progressInterval.
+  ProgressMonitor* progress = ProgressMonitor::GetInstance();
 
   G4VisManager* visManager = new G4VisExecutive;
   visManager->Initialize();
 
   G4UImanager* UImanager = G4UImanager::GetUIpointer();
 
-  if ( !ui ) {
+  if ( !ui && !macroName.empty() ) {
     // batch mode - Apply macros directly 
     UImanager->ApplyCommand("/control/macroPath ../macros/");
     UImanager->ApplyCommand("/control/execute init.mac");
+    if (importanceWorld) importanceWorld->CreateImportanceStore();
     G4String command = "/control/execute ";
-    G4String fileName = argv[1];
-    UImanager->ApplyCommand(command+fileName);
+    UImanager->ApplyCommand(command+macroName);
   } else {
     // Interactive Mode:
     UImanager->ApplyCommand("/control/macroPath ../macros");
     UImanager->ApplyCommand("/control/execute init.mac");
+    if (importanceWorld) importanceWorld->CreateImportanceStore();
+#ifdef BF3_USE_MPI
+    // Commands are read on rank 0 and sent to all ranks.
+    session->SessionStart();
+#else
     ui->SessionStart();
     delete ui;
+#endif
   }
 
   // Job termination
@@ -72,7 +254,18 @@ int main(int argc, char** argv)
   // owned and deleted by the run manager, so they should not be deleted 
   // in the main() program !
 
+  delete sweep;
+  delete optimizer;
+  delete checkpoint;
+  delete convergenceStop;
+  delete progress;
+  delete streams;
+  delete tableCache;
+  delete importanceSampler;
   delete visManager;
+#ifdef BF3_USE_MPI
+  delete g4MPI;
+#endif
   delete runManager;
 
 }
\ No newline at end of file
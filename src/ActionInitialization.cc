@@ -8,6 +8,8 @@
 #include "PrimaryGeneratorAction.hh"
 #include "RunAction.hh"
 #include "EventAction.hh"
+#include "StackingAction.hh"
+#include "TrackingAction.hh"
 #include "G4Threading.hh"
 
 ActionInitialization::ActionInitialization() : G4VUserActionInitialization()
@@ -35,5 +37,7 @@ void ActionInitialization::Build() const
 {
   SetUserAction(new PrimaryGeneratorAction);
   SetUserAction(new EventAction);
+  SetUserAction(new StackingAction);
+  SetUserAction(new TrackingAction);
   SetUserAction(new RunAction());
 }
\ No newline at end of file
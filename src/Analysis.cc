@@ -7,19 +7,16 @@
 #include "G4AutoDelete.hh"
 #include "G4SystemOfUnits.hh"
 #include "Analysis.hh"
+#include "Run.hh"
 #include "G4MultiFunctionalDetector.hh"
 #include "G4VPrimitiveScorer.hh"
 #include "G4SDManager.hh"
 #include "G4GenericAnalysisManager.hh"
 #include "G4RootAnalysisManager.hh"
-#include "G4ConvergenceTester.hh"
 
-G4ThreadLocal Analysis* theAnalysis = 0;
+#include <fstream>
 
-namespace {
-  G4Mutex aMutex = G4MUTEX_INITIALIZER;
-  G4ConvergenceTester* fConvTest1 = new G4ConvergenceTester("ConvTest1");
-}
+G4ThreadLocal Analysis* theAnalysis = 0;
 
 Analysis::Analysis()
 {
@@ -28,7 +25,9 @@ Analysis::Analysis()
   eDepHistTot = 0;
   primEneHist = 0;
   primPosHist = 0;
+  runInfoHist = 0;
   convergenceName = "";
+  runInfo = "";
 }
 
 //
@@ -53,9 +52,10 @@ Analysis* Analysis::GetAnalysis()
 //
 //
 
-void Analysis::Book(G4String runName)
+void Analysis::Book(G4String runName, const G4String& info)
 {
   convergenceName = runName;
+  runInfo = info;
   G4GenericAnalysisManager* man = G4GenericAnalysisManager::Instance();
   man->SetVerboseLevel(2);
   #ifdef G4MULTITHREADED
@@ -68,10 +68,10 @@ void Analysis::Book(G4String runName)
   eDepHist2 = man->CreateH1("BF3EnergyDep2", "BF3EnergyDep2", 512, 0., 5.);
   eDepHistTot = man->CreateH1("BF3EnergyDepTot", "BF3EnergyDepTot", 512, 0., 5.);
 
-const std::vector<G4double> binEdges = {1.00E-11,1.00E-07,4.14E-07,8.76E-07,1.86E-06,5.04E-06,1.07E-05,3.73E-05,1.01E-04,2.14E-04,4.54E-04,1.58E-03,3.35E-03,7.10E-03,1.50E-02,2.19E-02,2.42E-02,3.18E-02,4.09E-02,6.74E-02,1.11E-01,1.83E-01,2.97E-01,3.69E-01,4.98E-01,6.08E-01,7.43E-01,8.23E-01,1.00E+00,1.35E+00,1.65E+00,1.92E+00,2.23E+00,2.35E+00,2.37E+00,2.47E+00,2.73E+00,3.01E+00,3.68E+00,4.97E+00,6.07E+00,7.41E+00,8.61E+00,1.00E+01,1.22E+01,1.42E+01,1.73E+01};
-
-  primEneHist = man->CreateH1("PrimEnergy", "PrimaryEnergy", binEdges);
+  primEneHist = man->CreateH1("PrimEnergy", "PrimaryEnergy", GetPrimaryEnergyEdges());
   primPosHist = man->CreateH2("PrimaryPosition", "PrimaryPosition", 180, -9., 9., 110, -5.5, 5.5);
+  // Title: setup and random stream; content: number of events.
+  runInfoHist = man->CreateH1("RunInfo", runInfo, 1, 0., 1.);
   
   return; 
 }
@@ -79,32 +79,19 @@ const std::vector<G4double> binEdges = {1.00E-11,1.00E-07,4.14E-07,8.76E-07,1.86
 //
 //
 
-void Analysis::OpenFile(const G4String& fileName)
+const std::vector<G4double>& Analysis::GetPrimaryEnergyEdges()
 {
-  G4GenericAnalysisManager* man = G4GenericAnalysisManager::Instance();
-  man->OpenFile(fileName.c_str());
-
-  return;
+  static const std::vector<G4double> binEdges = {1.00E-11,1.00E-07,4.14E-07,8.76E-07,1.86E-06,5.04E-06,1.07E-05,3.73E-05,1.01E-04,2.14E-04,4.54E-04,1.58E-03,3.35E-03,7.10E-03,1.50E-02,2.19E-02,2.42E-02,3.18E-02,4.09E-02,6.74E-02,1.11E-01,1.83E-01,2.97E-01,3.69E-01,4.98E-01,6.08E-01,7.43E-01,8.23E-01,1.00E+00,1.35E+00,1.65E+00,1.92E+00,2.23E+00,2.35E+00,2.37E+00,2.47E+00,2.73E+00,3.01E+00,3.68E+00,4.97E+00,6.07E+00,7.41E+00,8.61E+00,1.00E+01,1.22E+01,1.42E+01,1.73E+01};
+  return binEdges;
 }
 
 //
 //
 
-void Analysis::Save()
-{
-  G4GenericAnalysisManager* man = G4GenericAnalysisManager::Instance();
-  man->Write();
-
-  return;
-}
-
-//
-//
-
-void Analysis::Close(G4bool reset)
+void Analysis::OpenFile(const G4String& fileName)
 {
   G4GenericAnalysisManager* man = G4GenericAnalysisManager::Instance();
-  man->CloseFile(reset);
+  man->OpenFile(fileName.c_str());
 
   return;
 }
@@ -112,67 +99,62 @@ void Analysis::Close(G4bool reset)
 //
 //
 
-void Analysis::FillEDep1(G4double eDep)
+void Analysis::Save()
 {
-  //G4cout << "Adding Energy Deposittion. " << G4endl;+
   G4GenericAnalysisManager* man = G4GenericAnalysisManager::Instance();
-  man->FillH1(eDepHist1, eDep);
-  G4AutoLock l(&aMutex);
-  fConvTest1->AddScore(eDep);
-  return;
-}
-
-//
-//
+  man->Write();
 
-void Analysis::FillEDep2(G4double eDep)
-{
-  //G4cout << "Adding Energy Deposittion. " << G4endl;+
-  G4GenericAnalysisManager* man = G4GenericAnalysisManager::Instance();
-  man->FillH1(eDepHist2, eDep);
   return;
 }
 
 //
 //
 
-void Analysis::FillEDepTot(G4double eDep)
+void Analysis::Close(G4bool reset)
 {
-  //G4cout << "Adding Energy Deposittion. " << G4endl;+
   G4GenericAnalysisManager* man = G4GenericAnalysisManager::Instance();
-  man->FillH1(eDepHistTot, eDep);
-  return;
-}
-
-//
-//
+  man->CloseFile(reset);
 
-void Analysis::FillPrimaryEne(G4double energy)
-{ 
-  G4GenericAnalysisManager* man = G4GenericAnalysisManager::Instance();
-  man->FillH1(primEneHist, energy);
   return;
 }
 
 //
 //
 
-void Analysis::FillPrimaryPos(G4double xPos, G4double yPos)
+void Analysis::WriteTallies(const Run* aRun)
 {
+  // The per-thread tallies are already merged into the master Run, so the
+  // histograms are only touched once per run.
   G4GenericAnalysisManager* man = G4GenericAnalysisManager::Instance();
-  man->FillH2(primPosHist, xPos, yPos);
+  aRun->GetEDep1().AddTo(man->GetH1(eDepHist1));
+  aRun->GetEDep2().AddTo(man->GetH1(eDepHist2));
+  aRun->GetEDepTot().AddTo(man->GetH1(eDepHistTot));
+  aRun->GetPrimaryEne().AddTo(man->GetH1(primEneHist));
+  aRun->GetPrimaryPos().AddTo(man->GetH2(primPosHist));
+  // The content of the RunInfo histogram is the number of events, which
+  // is also the history count of the convergence sums.
+  man->FillH1(runInfoHist, 0.5, aRun->GetNumberOfHistories());
   return;
 }
 
 //
 //
 
-void Analysis::CheckConvergence()
+void Analysis::CheckConvergence(const Run* aRun, G4double runTime, const G4String& note)
 {
   std::ofstream convOutput;
   convOutput.open(convergenceName+"-conv.txt");
-  fConvTest1->ShowResult(convOutput);
-  fConvTest1->ShowHistory(convOutput);
+  convOutput << "# " << runInfo << std::endl;
+  if (!note.empty()) convOutput << "# " << note << std::endl;
+  aRun->GetConvergence1().ShowResult(convOutput, runTime);
+  aRun->GetConvergence2().ShowResult(convOutput, runTime);
+  aRun->GetConvergenceTot().ShowResult(convOutput, runTime);
+  aRun->GetDetected().ShowResult(convOutput, runTime);
+  convOutput << std::endl;
+  aRun->GetConvergence1().ShowHistory(convOutput, runTime);
+  aRun->GetConvergence2().ShowHistory(convOutput, runTime);
+  aRun->GetConvergenceTot().ShowHistory(convOutput, runTime);
+  aRun->GetDetected().ShowHistory(convOutput, runTime);
   convOutput.close();
 
   return;
@@ -0,0 +1,117 @@
+// Source code for BF3SensitiveDetector().
+// Created by agent on October 17, 2026.
+
+/// \file BF3SensitiveDetector.cc
+/// \brief Source code for BF3SensitiveDetector class.
+
+#include "BF3SensitiveDetector.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4VProcess.hh"
+
+namespace {
+  G4ThreadLocal BF3SensitiveDetector::EventBuffer theEventBuffer = {{0., 0.}, {0., 0.}, {0., 0.}, 0., 0.};
+}
+
+BF3SensitiveDetector::BF3SensitiveDetector(const G4String& name, G4int tubeIndex)
+: G4VSensitiveDetector(name), fTubeIndex(tubeIndex), fLastDefinition(0), fLastAccepted(false)
+{
+  // Same particles as the former "NeutronFilter":
+  AddIon(0, 1); // neutron
+  AddIon(1, 1); // proton
+  AddIon(1, 2); // deuteron
+  AddIon(1, 3); // triton
+  AddIon(2, 4); // alpha
+  AddIon(3, 6); // Li6
+  AddIon(3, 7); // Li7
+  AddIon(4, 8); // Be8
+  AddIon(4, 9); // Be9
+  AddIon(4, 10); // Be10
+  AddIon(5, 10); // B-10
+  AddIon(5, 11); // B-11
+}
+
+//
+//
+
+BF3SensitiveDetector::~BF3SensitiveDetector()
+{}
+
+//
+//
+
+void BF3SensitiveDetector::AddIon(G4int Z, G4int A)
+{
+  fAccepted.set(Z*kMaxA + A);
+}
+
+//
+//
+
+G4bool BF3SensitiveDetector::Accept(const G4ParticleDefinition* def)
+{
+  // Consecutive steps nearly always come from the same particle type.
+  if (def == fLastDefinition) return fLastAccepted;
+  G4int code = def->GetPDGEncoding();
+  G4int Z = -1;
+  G4int A = -1;
+  if (code == 2112) {
+    Z = 0; A = 1;
+  } else if (code == 2212) {
+    Z = 1; A = 1;
+  } else if (code > 1000000000) {
+    // Ions: 10LZZZAAAI, any excitation level.
+    Z = (code/10000)%1000;
+    A = (code/10)%1000;
+  }
+  fLastDefinition = def;
+  fLastAccepted = (Z >= 0 && Z < kMaxZ && A >= 0 && A < kMaxA && fAccepted.test(Z*kMaxA + A));
+  return fLastAccepted;
+}
+
+//
+//
+
+void BF3SensitiveDetector::Initialize(G4HCofThisEvent*)
+{
+  theEventBuffer.eDep[fTubeIndex] = 0.;
+  theEventBuffer.weightedEDep[fTubeIndex] = 0.;
+  theEventBuffer.weight[fTubeIndex] = 0.;
+  theEventBuffer.detectionWeight = 0.;
+  theEventBuffer.captureWeight = 0.;
+}
+
+//
+//
+
+G4bool BF3SensitiveDetector::ProcessHits(G4Step* aStep, G4TouchableHistory*)
+{
+  G4double eDep = aStep->GetTotalEnergyDeposit();
+  if (eDep == 0.) return false;
+  const G4Track* track = aStep->GetTrack();
+  if (!Accept(track->GetDefinition())) return false;
+  G4double weight = aStep->GetPreStepPoint()->GetWeight();
+  // The first step of a Li-7 made in the gas; excited Li-7 de-excited by
+  // a decay process is not a second capture.
+  if (track->GetCurrentStepNumber() == 1 && track->GetDefinition()->GetPDGEncoding()/10 == 100003007
+      && !(track->GetCreatorProcess() && track->GetCreatorProcess()->GetProcessType() == fDecay)) {
+    theEventBuffer.captureWeight += weight;
+  }
+  if (theEventBuffer.eDep[fTubeIndex] == 0.) {
+    theEventBuffer.weight[fTubeIndex] = weight;
+    if (theEventBuffer.detectionWeight == 0.) theEventBuffer.detectionWeight = weight;
+  }
+  theEventBuffer.eDep[fTubeIndex] += eDep;
+  theEventBuffer.weightedEDep[fTubeIndex] += weight*eDep;
+  return true;
+}
+
+//
+//
+
+const BF3SensitiveDetector::EventBuffer& BF3SensitiveDetector::GetEventBuffer()
+{
+  return theEventBuffer;
+}
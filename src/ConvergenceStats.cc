@@ -0,0 +1,197 @@
+// Source code for ConvergenceStats().
+// Created by agent on October 17, 2026.
+
+/// \file ConvergenceStats.cc
+/// \brief Source code for ConvergenceStats class.
+
+#include "ConvergenceStats.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+void ConvergenceStats::Moments::Add(const Moments& other)
+{
+  n += other.n;
+  nonZero += other.nonZero;
+  s1 += other.s1;
+  s2 += other.s2;
+  s3 += other.s3;
+  s4 += other.s4;
+}
+
+//
+//
+
+ConvergenceStats::ConvergenceStats(const G4String& name, G4double firstCheckpoint)
+: fName(name), fFirstCheckpoint(firstCheckpoint), fNextCheckpoint(firstCheckpoint)
+{}
+
+//
+//
+
+ConvergenceStats::~ConvergenceStats()
+{}
+
+//
+//
+
+void ConvergenceStats::Reset()
+{
+  fSum = Moments();
+  fHistory.clear();
+  fNextCheckpoint = fFirstCheckpoint;
+}
+
+//
+//
+
+void ConvergenceStats::Checkpoint()
+{
+  fHistory.push_back(fSum);
+  fNextCheckpoint *= 2.;
+}
+
+//
+//
+
+void ConvergenceStats::Merge(const ConvergenceStats& other)
+{
+  // The k-th snapshot of every thread is taken at the same local history
+  // count, so adding them gives the k-th snapshot of the merged run.
+  // Snapshots not reached by every thread are dropped, as is the padding
+  // of a received run. An empty run (a thread without events) has no
+  // snapshots and must not truncate the history.
+  if (other.fSum.n == 0.) return;
+  size_t nOther = 0;
+  while (nOther < other.fHistory.size() && other.fHistory[nOther].n > 0.) nOther++;
+  if (fSum.n == 0.) {
+    fHistory.assign(other.fHistory.begin(), other.fHistory.begin() + nOther);
+  } else {
+    fHistory.resize(std::min(fHistory.size(), nOther));
+    for (size_t i = 0; i < fHistory.size(); i++) {
+      fHistory[i].Add(other.fHistory[i]);
+    }
+  }
+  fSum.Add(other.fSum);
+}
+
+//
+//
+
+void ConvergenceStats::GetBlocks(std::vector<std::pair<G4double*, G4int> >& blocks)
+{
+  static_assert(sizeof(Moments) == 6*sizeof(G4double), "Moments must be six packed doubles");
+  fHistory.resize(kMaxSnapshots);
+  blocks.push_back(std::make_pair(&fSum.n, 6));
+  blocks.push_back(std::make_pair(&fHistory[0].n, 6*kMaxSnapshots));
+}
+
+//
+//
+
+G4double ConvergenceStats::Mean(const Moments& m)
+{
+  if (m.n <= 0.) return 0.;
+  return m.s1/m.n;
+}
+
+//
+//
+
+G4double ConvergenceStats::RelativeError(const Moments& m)
+{
+  if (m.n <= 1. || m.s1 <= 0.) return 0.;
+  G4double mean = m.s1/m.n;
+  G4double var = (m.s2/m.n - mean*mean)/(m.n - 1.);
+  if (var <= 0.) return 0.;
+  return std::sqrt(var)/mean;
+}
+
+//
+//
+
+G4double ConvergenceStats::VOV(const Moments& m)
+{
+  if (m.n <= 0. || m.s1 <= 0.) return 0.;
+  G4double mean = m.s1/m.n;
+  G4double mean2 = mean*mean;
+  // Central sums expanded from the raw power sums.
+  G4double c2 = m.s2 - m.n*mean2;
+  G4double c4 = m.s4 - 4.*mean*m.s3 + 6.*mean2*m.s2 - 3.*m.n*mean2*mean2;
+  if (c2 <= 0.) return 0.;
+  return c4/(c2*c2) - 1./m.n;
+}
+
+//
+//
+
+G4double ConvergenceStats::GetMean() const
+{
+  return Mean(fSum);
+}
+
+//
+//
+
+G4double ConvergenceStats::GetRelativeError() const
+{
+  return RelativeError(fSum);
+}
+
+//
+//
+
+G4double ConvergenceStats::GetVOV() const
+{
+  return VOV(fSum);
+}
+
+//
+//
+
+G4double ConvergenceStats::GetFOM(G4double time) const
+{
+  G4double re = GetRelativeError();
+  if (re <= 0. || time <= 0.) return 0.;
+  return 1./(re*re*time);
+}
+
+//
+//
+
+void ConvergenceStats::ShowResult(std::ostream& out, G4double time) const
+{
+  out << std::setprecision(6);
+  out << "ConvergenceStats " << fName << std::endl;
+  out << "  Histories:          " << fSum.n << std::endl;
+  out << "  Non-zero histories: " << fSum.nonZero << std::endl;
+  out << "  Mean:               " << GetMean() << std::endl;
+  out << "  Relative error:     " << GetRelativeError() << std::endl;
+  out << "  VOV:                " << GetVOV() << std::endl;
+  out << "  FOM:                " << GetFOM(time) << std::endl;
+  out << "  Time [s]:           " << time << std::endl;
+}
+
+//
+//
+
+void ConvergenceStats::ShowHistory(std::ostream& out, G4double time) const
+{
+  // The run time is only known at the end, so the FOM of each checkpoint
+  // assumes a constant event rate.
+  out << "History of " << fName << std::endl;
+  out << std::setw(16) << "Histories" << std::setw(16) << "Mean"
+      << std::setw(16) << "RelError" << std::setw(16) << "VOV"
+      << std::setw(16) << "FOM" << std::endl;
+  std::vector<Moments> points = fHistory;
+  if (points.empty() || points.back().n < fSum.n) points.push_back(fSum);
+  for (auto itr = points.begin(); itr != points.end(); itr++) {
+    G4double re = RelativeError(*itr);
+    G4double t = (fSum.n > 0.) ? time*itr->n/fSum.n : 0.;
+    G4double fom = (re > 0. && t > 0.) ? 1./(re*re*t) : 0.;
+    out << std::setw(16) << itr->n << std::setw(16) << Mean(*itr)
+        << std::setw(16) << re << std::setw(16) << VOV(*itr)
+        << std::setw(16) << fom << std::endl;
+  }
+}
@@ -0,0 +1,178 @@
+// Source code for ConvergenceStop().
+// Created by agent on October 17, 2026.
+
+/// \file ConvergenceStop.cc
+/// \brief Source code for ConvergenceStop class.
+
+#include "ConvergenceStop.hh"
+#include "ConvergenceStopMessenger.hh"
+#include "Run.hh"
+
+#include "G4RunManager.hh"
+#include "G4AutoLock.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace {
+  ConvergenceStop* theStop = 0;
+
+  const Tally1D* FindTally(const Run* aRun, const G4String& name)
+  {
+    if (name == "BF3EnergyDep1") return &aRun->GetEDep1();
+    if (name == "BF3EnergyDep2") return &aRun->GetEDep2();
+    if (name == "BF3EnergyDepTot") return &aRun->GetEDepTot();
+    if (name == "PrimEnergy") return &aRun->GetPrimaryEne();
+    return 0;
+  }
+}
+
+ConvergenceStop::ConvergenceStop()
+: fCheckInterval(10000), fMinEvents(0.), fStop(false), fEvents(0.), fDecision("")
+{
+  for (G4int i = 0; i < kMaxTargets; i++) {
+    fSumW[i] = 0.;
+    fSumW2[i] = 0.;
+  }
+  G4MUTEXINIT(fDecisionMutex);
+  fMessenger = new ConvergenceStopMessenger(this);
+}
+
+//
+//
+
+ConvergenceStop::~ConvergenceStop()
+{
+  delete fMessenger;
+}
+
+//
+//
+
+ConvergenceStop* ConvergenceStop::GetInstance()
+{
+  // Created on the master in main(); the workers share the sums.
+  if (!theStop) {
+    theStop = new ConvergenceStop();
+  }
+  return theStop;
+}
+
+//
+//
+
+G4bool ConvergenceStop::AddTarget(const G4String& tally, G4double emin, G4double emax,
+                                  G4double relError)
+{
+  if (G4int(fTargets.size()) == kMaxTargets) {
+    G4cout << "ConvergenceStop: at most " << kMaxTargets << " targets." << G4endl;
+    return false;
+  }
+  G4bool known = (tally == "BF3EnergyDep1" || tally == "BF3EnergyDep2"
+                  || tally == "BF3EnergyDepTot" || tally == "PrimEnergy"
+                  || tally == "BF3Detected");
+  if (!known || emax < emin) {
+    G4cout << "ConvergenceStop: unknown tally " << tally << " or empty range." << G4endl;
+    return false;
+  }
+  if (tally != "PrimEnergy" && tally != "BF3Detected" && !Run::HasPulseHeightTallies()) {
+    G4cout << "ConvergenceStop: no pulse height tallies with importance splitting,"
+           << " use BF3Detected." << G4endl;
+    return false;
+  }
+  Target target = {tally, emin, emax, relError};
+  fTargets.push_back(target);
+  return true;
+}
+
+//
+//
+
+void ConvergenceStop::AtomicAdd(std::atomic<G4double>& sum, G4double x)
+{
+  G4double old = sum.load(std::memory_order_relaxed);
+  while (!sum.compare_exchange_weak(old, old + x, std::memory_order_relaxed)) {}
+}
+
+//
+//
+
+void ConvergenceStop::BeginRun()
+{
+  fStop = false;
+  fEvents = 0.;
+  for (G4int i = 0; i < kMaxTargets; i++) {
+    fSumW[i] = 0.;
+    fSumW2[i] = 0.;
+  }
+  fDecision = IsActive() ? "not stopped: targets not reached" : "";
+}
+
+//
+//
+
+void ConvergenceStop::Report(const Run* aRun, Published& published)
+{
+  // Add what this thread scored since its last report.
+  AtomicAdd(fEvents, published.events);
+  published.events = 0;
+  for (size_t t = 0; t < fTargets.size(); t++) {
+    G4double sumW = 0.;
+    G4double sumW2 = 0.;
+    if (fTargets[t].tally == "BF3Detected") {
+      // Scored per history, the range does not apply.
+      sumW = aRun->GetDetected().GetSum();
+      sumW2 = aRun->GetDetected().GetSumSquares();
+    } else {
+      const Tally1D* tally = FindTally(aRun, fTargets[t].tally);
+      G4int first = tally->FindBin(fTargets[t].emin/MeV);
+      G4int last = std::min(tally->FindBin(fTargets[t].emax/MeV), tally->GetNbins() + 1);
+      for (G4int i = first; i <= last; i++) {
+        sumW += tally->GetSw(i);
+        sumW2 += tally->GetSw2(i);
+      }
+    }
+    AtomicAdd(fSumW[t], sumW - published.sumW[t]);
+    AtomicAdd(fSumW2[t], sumW2 - published.sumW2[t]);
+    published.sumW[t] = sumW;
+    published.sumW2[t] = sumW2;
+  }
+
+  // Check the targets against the shared sums.
+  G4double events = fEvents.load(std::memory_order_relaxed);
+  if (events < fMinEvents || fStop.load(std::memory_order_relaxed)) return;
+  std::ostringstream decision;
+  decision << "stopped after " << events << " events:";
+  for (size_t t = 0; t < fTargets.size(); t++) {
+    G4double sumW = fSumW[t].load(std::memory_order_relaxed);
+    G4double sumW2 = fSumW2[t].load(std::memory_order_relaxed);
+    if (sumW <= 0.) return;
+    G4double relError = std::sqrt(sumW2)/sumW;
+    if (relError > fTargets[t].relError) return;
+    decision << " " << fTargets[t].tally << " [" << fTargets[t].emin/MeV << ", "
+             << fTargets[t].emax/MeV << "] MeV relError " << relError
+             << " <= " << fTargets[t].relError << ";";
+  }
+  G4AutoLock lock(&fDecisionMutex);
+  if (fStop.exchange(true)) return;
+  fDecision = decision.str();
+}
+
+//
+//
+
+void ConvergenceStop::Stop() const
+{
+  // Soft abort: the current event is finished and recorded.
+  G4RunManager::GetRunManager()->AbortRun(true);
+}
+
+//
+//
+
+G4String ConvergenceStop::GetDecision() const
+{
+  return fDecision;
+}
@@ -0,0 +1,103 @@
+// Source code for ConvergenceStopMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file ConvergenceStopMessenger.cc
+/// \file Source code for ConvergenceStopMessenger class.
+
+#include "ConvergenceStop.hh"
+#include "ConvergenceStopMessenger.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include <sstream>
+
+ConvergenceStopMessenger::ConvergenceStopMessenger(ConvergenceStop* myStop)
+: G4UImessenger(), fStop(myStop)
+{
+  fStopDir = new G4UIdirectory("/BF3/stop/");
+  fStopDir->SetGuidance("End runs once the target relative errors are reached.");
+
+  fAddTarget = new G4UIcommand("/BF3/stop/addTarget", this);
+  fAddTarget->SetGuidance("Add a target: the summed bins of a tally from emin to emax");
+  fAddTarget->SetGuidance("must reach the relative error. All targets must be met, e.g.");
+  fAddTarget->SetGuidance("  /BF3/stop/addTarget BF3EnergyDepTot 0.1 10 MeV 0.01");
+  fAddTarget->SetGuidance("for the total count rate above 100 keV (overflow included).");
+  fAddTarget->SetGuidance("BF3Detected ignores the range; it is the count rate that is");
+  fAddTarget->SetGuidance("left with importance splitting.");
+  G4UIparameter* tally = new G4UIparameter("tally", 's', false);
+  tally->SetParameterCandidates("BF3EnergyDep1 BF3EnergyDep2 BF3EnergyDepTot PrimEnergy BF3Detected");
+  fAddTarget->SetParameter(tally);
+  G4UIparameter* emin = new G4UIparameter("emin", 'd', false);
+  fAddTarget->SetParameter(emin);
+  G4UIparameter* emax = new G4UIparameter("emax", 'd', false);
+  fAddTarget->SetParameter(emax);
+  G4UIparameter* unit = new G4UIparameter("unit", 's', true);
+  unit->SetDefaultValue("MeV");
+  fAddTarget->SetParameter(unit);
+  G4UIparameter* relError = new G4UIparameter("relError", 'd', true);
+  relError->SetDefaultValue(0.01);
+  relError->SetParameterRange("relError>0.");
+  fAddTarget->SetParameter(relError);
+  fAddTarget->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fClearTargets = new G4UIcmdWithoutParameter("/BF3/stop/clearTargets", this);
+  fClearTargets->SetGuidance("Remove all targets; runs then go to their full length.");
+  fClearTargets->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fCheckInterval = new G4UIcmdWithAnInteger("/BF3/stop/checkInterval", this);
+  fCheckInterval->SetGuidance("Events of a thread between its reports to the shared sums.");
+  fCheckInterval->SetParameterName("events", false);
+  fCheckInterval->SetRange("events>0");
+  fCheckInterval->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fMinEvents = new G4UIcmdWithADouble("/BF3/stop/minEvents", this);
+  fMinEvents->SetGuidance("Never stop before this many events, so the error estimate");
+  fMinEvents->SetGuidance("is not based on a handful of counts.");
+  fMinEvents->SetParameterName("events", false);
+  fMinEvents->SetRange("events>=0.");
+  fMinEvents->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  // The targets are shared; only the master sets them.
+  fAddTarget->SetToBeBroadcasted(false);
+  fClearTargets->SetToBeBroadcasted(false);
+  fCheckInterval->SetToBeBroadcasted(false);
+  fMinEvents->SetToBeBroadcasted(false);
+}
+
+//
+//
+
+ConvergenceStopMessenger::~ConvergenceStopMessenger()
+{
+  delete fAddTarget;
+  delete fClearTargets;
+  delete fCheckInterval;
+  delete fMinEvents;
+  delete fStopDir;
+}
+
+//
+//
+
+void ConvergenceStopMessenger::SetNewValue(G4UIcommand* command, G4String newVal)
+{
+  if (command == fAddTarget) {
+    G4String tally, unit;
+    G4double emin, emax, relError;
+    std::istringstream is(newVal);
+    is >> tally >> emin >> emax >> unit >> relError;
+    G4double factor = G4UIcommand::ValueOf(unit);
+    fStop->AddTarget(tally, emin*factor, emax*factor, relError);
+  } else if (command == fClearTargets) {
+    fStop->ClearTargets();
+  } else if (command == fCheckInterval) {
+    fStop->SetCheckInterval(fCheckInterval->GetNewIntValue(newVal));
+  } else if (command == fMinEvents) {
+    fStop->SetMinEvents(fMinEvents->GetNewDoubleValue(newVal));
+  }
+}
@@ -0,0 +1,252 @@
+// Source code for DesignOptimizer().
+// Created by agent on October 17, 2026.
+
+/// \file DesignOptimizer.cc
+/// \brief Source code for DesignOptimizer class.
+
+#include "DesignOptimizer.hh"
+#include "DesignOptimizerMessenger.hh"
+#include "Run.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4RunManager.hh"
+#include "G4UImanager.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+  DesignOptimizer* theOptimizer = 0;
+}
+
+DesignOptimizer::DesignOptimizer()
+: fEventsFirstRound(20000), fReduction(3.), fConfidence(3.), fTargetError(0.01),
+  fMaxEvents(1.e9), fThreshold(0.), fFileName("BF3DesignRanking.txt"),
+  fNormalization("fluence"), fRunning(false), fCurrent(0)
+{
+  fMessenger = new DesignOptimizerMessenger(this);
+}
+
+//
+//
+
+DesignOptimizer::~DesignOptimizer()
+{
+  delete fMessenger;
+}
+
+//
+//
+
+DesignOptimizer* DesignOptimizer::GetInstance()
+{
+  // Only the master thread drives the search.
+  if (!theOptimizer) {
+    theOptimizer = new DesignOptimizer();
+  }
+  return theOptimizer;
+}
+
+//
+//
+
+void DesignOptimizer::AddScan(const G4String& command, const G4String& unit,
+                              const std::vector<G4String>& values)
+{
+  if (values.empty()) {
+    G4cout << "DesignOptimizer: no values given for " << command << ", ignored." << G4endl;
+    return;
+  }
+  Scan scan = {command, unit, values};
+  fScans.push_back(scan);
+}
+
+//
+//
+
+void DesignOptimizer::ClearScans()
+{
+  fScans.clear();
+}
+
+//
+//
+
+void DesignOptimizer::ApplyDesign(const Design& design) const
+{
+  G4UImanager* UImanager = G4UImanager::GetUIpointer();
+  for (size_t i = 0; i < fScans.size(); i++) {
+    G4String value = fScans[i].values[design.index[i]];
+    std::replace(value.begin(), value.end(), ',', ' ');
+    G4String command = fScans[i].command + " " + value;
+    if (!fScans[i].unit.empty()) command += " " + fScans[i].unit;
+    if (UImanager->ApplyCommand(command) != 0) {
+      G4ExceptionDescription msg;
+      msg << "Design command \"" << command << "\" failed.";
+      G4Exception("DesignOptimizer::ApplyDesign()", "BF3Opt001", FatalException, msg);
+    }
+  }
+}
+
+//
+//
+
+void DesignOptimizer::Start()
+{
+  if (!Run::HasPulseHeightTallies()) {
+    G4cout << "DesignOptimizer: importance splitting, the counts are the weighted"
+           << " captures in the gas and the threshold is not used." << G4endl;
+  }
+  if (fScans.empty()) {
+    G4cout << "DesignOptimizer: no scanned parameters given, nothing to do." << G4endl;
+    return;
+  }
+  // Every combination of the scanned values is one design.
+  fDesigns.clear();
+  std::vector<size_t> index(fScans.size(), 0);
+  while (true) {
+    Design design;
+    design.index = index;
+    fDesigns.push_back(design);
+    size_t i = 0;
+    while (i < fScans.size() && ++index[i] == fScans[i].values.size()) index[i++] = 0;
+    if (i == fScans.size()) break;
+  }
+  G4cout << "DesignOptimizer: " << fDesigns.size() << " designs." << G4endl;
+
+  G4RunManager* runManager = G4RunManager::GetRunManager();
+  G4double used = 0.;
+  G4double roundEvents = fEventsFirstRound;
+  G4double roundBudget = fEventsFirstRound*static_cast<G4double>(fDesigns.size());
+  G4bool done = false;
+  fRunning = true;
+  for (G4int round = 1; !done; round++) {
+    std::vector<Design*> alive;
+    for (auto& design : fDesigns) {
+      if (design.alive) alive.push_back(&design);
+    }
+    // A round never costs more than the first one, nor more than is left
+    // of the budget; fewer survivors get more events each instead.
+    G4double perDesign = std::min(roundEvents, roundBudget/alive.size());
+    perDesign = std::min(perDesign, (fMaxEvents - used)/alive.size());
+    if (perDesign < fEventsFirstRound) {
+      G4cout << "DesignOptimizer: event budget used up." << G4endl;
+      break;
+    }
+    G4int nEvents = static_cast<G4int>(std::min(perDesign, 2.147e9));
+    for (auto design : alive) {
+      ApplyDesign(*design);
+      fCurrent = design;
+      runManager->BeamOn(nEvents);
+      design->rounds = round;
+      used += nEvents;
+    }
+    fCurrent = 0;
+
+    // Drop everything clearly below the leader.
+    auto byValue = [](const Design* a, const Design* b) { return a->Value() > b->Value(); };
+    std::sort(alive.begin(), alive.end(), byValue);
+    const Design* leader = alive.front();
+    G4double leaderLow = leader->Value() - fConfidence*leader->Error();
+    for (auto design : alive) {
+      if (design->Value() + fConfidence*design->Error() < leaderLow) design->alive = false;
+    }
+    alive.erase(std::remove_if(alive.begin(), alive.end(),
+                               [](const Design* d) { return !d->alive; }), alive.end());
+
+    G4bool converged = true;
+    for (auto design : alive) {
+      if (design->Value() <= 0. || design->Error() > fTargetError*design->Value()) converged = false;
+    }
+    if (converged) {
+      // One winner or a statistical tie; more events will not change it.
+      done = true;
+    } else {
+      // Designs that cannot be told apart from the leader all go on.
+      roundEvents *= fReduction;
+    }
+    G4int nLeft = 0;
+    for (const auto& design : fDesigns) nLeft += design.alive;
+    G4cout << "DesignOptimizer: round " << round << ", " << nLeft
+           << " designs left, " << used << " events used." << G4endl;
+  }
+  fRunning = false;
+  WriteTable();
+
+  // Leave the best design in place for further runs.
+  const Design* best = 0;
+  for (const auto& design : fDesigns) {
+    if (!best || design.rounds > best->rounds
+        || (design.rounds == best->rounds && design.Value() > best->Value())) best = &design;
+  }
+  if (best) ApplyDesign(*best);
+  G4cout << "DesignOptimizer: ranking written to " << fFileName << G4endl;
+}
+
+//
+//
+
+void DesignOptimizer::RecordRun(const Run* aRun)
+{
+  if (!fRunning || !fCurrent) return;
+  if (Run::HasPulseHeightTallies()) {
+    // Counts of both tubes above the threshold, overflow included.
+    const Tally1D& phs = aRun->GetEDepTot();
+    G4int first = std::max(phs.FindBin(fThreshold/MeV), 1);
+    for (G4int i = first; i <= phs.GetNbins() + 1; i++) {
+      fCurrent->sumW += phs.GetSw(i);
+      fCurrent->sumW2 += phs.GetSw2(i);
+    }
+  } else {
+    // Split histories: weighted captures in the gas (see Run).
+    fCurrent->sumW += aRun->GetDetected().GetSum();
+    fCurrent->sumW2 += aRun->GetDetected().GetSumSquares();
+  }
+  fCurrent->events += aRun->GetNumberOfHistories();
+  if (fNormalization == "fluence") {
+    const DetectorConstruction* detector = static_cast<const DetectorConstruction*>(
+      G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+    G4ThreeVector size = detector->GetModeratorSize();
+    G4double area = 2.*(size.x()*size.y() + size.y()*size.z() + size.x()*size.z());
+    fCurrent->scale = 0.25*area/cm2;
+  } else {
+    fCurrent->scale = 1.;
+  }
+}
+
+//
+//
+
+void DesignOptimizer::WriteTable() const
+{
+  // Designs that got further rank first, then by counts.
+  std::vector<const Design*> ranked;
+  for (const auto& design : fDesigns) ranked.push_back(&design);
+  std::stable_sort(ranked.begin(), ranked.end(), [](const Design* a, const Design* b) {
+    if (a->rounds != b->rounds) return a->rounds > b->rounds;
+    return a->Value() > b->Value();
+  });
+
+  std::ofstream output(fFileName);
+  output << "# BF3 design ranking, threshold " << fThreshold/MeV << " MeV, counts per "
+         << ((fNormalization == "fluence") ? "unit fluence [cm2]" : "source neutron") << std::endl;
+  output << "# rank";
+  for (const auto& scan : fScans) {
+    output << " " << scan.command;
+    if (!scan.unit.empty()) output << "[" << scan.unit << "]";
+  }
+  output << " rounds events counts error relError survived" << std::endl;
+  output << std::setprecision(8);
+  for (size_t r = 0; r < ranked.size(); r++) {
+    const Design* design = ranked[r];
+    output << r + 1;
+    for (size_t i = 0; i < fScans.size(); i++) {
+      output << " " << fScans[i].values[design->index[i]];
+    }
+    G4double relError = (design->Value() > 0.) ? design->Error()/design->Value() : 0.;
+    output << " " << design->rounds << " " << design->events << " " << design->Value()
+           << " " << design->Error() << " " << relError << " " << design->alive << std::endl;
+  }
+}
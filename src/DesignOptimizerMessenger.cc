@@ -0,0 +1,168 @@
+// Source code for DesignOptimizerMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file DesignOptimizerMessenger.cc
+/// \file Source code for DesignOptimizerMessenger class.
+
+#include "DesignOptimizer.hh"
+#include "DesignOptimizerMessenger.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+#include <sstream>
+
+DesignOptimizerMessenger::DesignOptimizerMessenger(DesignOptimizer* myOptimizer)
+: G4UImessenger(), fOptimizer(myOptimizer)
+{
+  fOptDir = new G4UIdirectory("/BF3/opt/");
+  fOptDir->SetGuidance("Adaptive search over detector designs.");
+
+  fScan = new G4UIcommand("/BF3/opt/scan", this);
+  fScan->SetGuidance("Scan a design command over a list of values, e.g.");
+  fScan->SetGuidance("  /BF3/opt/scan /BF3/det/tubeGap cm 0.25 0.5 1.0");
+  fScan->SetGuidance("Give 3-vector values as x,y,z. Use - for a command without unit.");
+  fScan->SetGuidance("The designs are all combinations of the scanned values.");
+  G4UIparameter* command = new G4UIparameter("command", 's', false);
+  fScan->SetParameter(command);
+  G4UIparameter* unit = new G4UIparameter("unit", 's', false);
+  fScan->SetParameter(unit);
+  G4UIparameter* values = new G4UIparameter("values", 's', false);
+  fScan->SetParameter(values);
+  fScan->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fClearScans = new G4UIcmdWithoutParameter("/BF3/opt/clearScans", this);
+  fClearScans->SetGuidance("Remove all scanned parameters.");
+  fClearScans->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fEvents = new G4UIcmdWithAnInteger("/BF3/opt/eventsFirstRound", this);
+  fEvents->SetGuidance("Events per design in the first round.");
+  fEvents->SetParameterName("events", false);
+  fEvents->SetRange("events>0");
+  fEvents->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fReduction = new G4UIcmdWithADouble("/BF3/opt/reduction", this);
+  fReduction->SetGuidance("Each round gives the surviving designs reduction times more");
+  fReduction->SetGuidance("events, as long as the round costs no more than the first one.");
+  fReduction->SetParameterName("eta", false);
+  fReduction->SetRange("eta>1.");
+  fReduction->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fConfidence = new G4UIcmdWithADouble("/BF3/opt/confidence", this);
+  fConfidence->SetGuidance("Designs more than this many standard deviations below the");
+  fConfidence->SetGuidance("leader are dropped right away.");
+  fConfidence->SetParameterName("z", false);
+  fConfidence->SetRange("z>0.");
+  fConfidence->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fTargetError = new G4UIcmdWithADouble("/BF3/opt/targetError", this);
+  fTargetError->SetGuidance("Relative error at which the surviving designs are final.");
+  fTargetError->SetParameterName("relError", false);
+  fTargetError->SetRange("relError>0.");
+  fTargetError->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fMaxEvents = new G4UIcmdWithADouble("/BF3/opt/maxEvents", this);
+  fMaxEvents->SetGuidance("Total event budget of the search.");
+  fMaxEvents->SetParameterName("events", false);
+  fMaxEvents->SetRange("events>0.");
+  fMaxEvents->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fThreshold = new G4UIcmdWithADoubleAndUnit("/BF3/opt/threshold", this);
+  fThreshold->SetGuidance("Pulse height threshold for a count.");
+  fThreshold->SetParameterName("energy", false);
+  fThreshold->SetUnitCategory("Energy");
+  fThreshold->SetRange("energy>=0.");
+  fThreshold->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fFileName = new G4UIcmdWithAString("/BF3/opt/fileName", this);
+  fFileName->SetGuidance("Set the file name for the ranked design table.");
+  fFileName->SetParameterName("choice", false);
+  fFileName->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fNormalization = new G4UIcmdWithAString("/BF3/opt/normalization", this);
+  fNormalization->SetGuidance("What the counts of a design are divided by:");
+  fNormalization->SetGuidance("  fluence: unit fluence of an isotropic field, for /BF3/gun/source surface");
+  fNormalization->SetGuidance("  history: source neutrons, for a source that is the same for all designs");
+  fNormalization->SetParameterName("mode", false);
+  fNormalization->SetCandidates("fluence history");
+  fNormalization->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fRun = new G4UIcmdWithoutParameter("/BF3/opt/run", this);
+  fRun->SetGuidance("Run the search and write the ranked design table.");
+  fRun->AvailableForStates(G4State_Idle);
+
+  // The optimizer only exists on the master.
+  fScan->SetToBeBroadcasted(false);
+  fClearScans->SetToBeBroadcasted(false);
+  fEvents->SetToBeBroadcasted(false);
+  fReduction->SetToBeBroadcasted(false);
+  fConfidence->SetToBeBroadcasted(false);
+  fTargetError->SetToBeBroadcasted(false);
+  fMaxEvents->SetToBeBroadcasted(false);
+  fThreshold->SetToBeBroadcasted(false);
+  fFileName->SetToBeBroadcasted(false);
+  fNormalization->SetToBeBroadcasted(false);
+  fRun->SetToBeBroadcasted(false);
+}
+
+//
+//
+
+DesignOptimizerMessenger::~DesignOptimizerMessenger()
+{
+  delete fScan;
+  delete fClearScans;
+  delete fEvents;
+  delete fReduction;
+  delete fConfidence;
+  delete fTargetError;
+  delete fMaxEvents;
+  delete fThreshold;
+  delete fFileName;
+  delete fNormalization;
+  delete fRun;
+  delete fOptDir;
+}
+
+//
+//
+
+void DesignOptimizerMessenger::SetNewValue(G4UIcommand* command, G4String newVal)
+{
+  if (command == fScan) {
+    // The last string parameter takes the rest of the line.
+    G4String cmd, unit, value;
+    std::vector<G4String> values;
+    std::istringstream is(newVal);
+    is >> cmd >> unit;
+    while (is >> value) values.push_back(value);
+    if (unit == "-") unit = "";
+    fOptimizer->AddScan(cmd, unit, values);
+  } else if (command == fClearScans) {
+    fOptimizer->ClearScans();
+  } else if (command == fEvents) {
+    fOptimizer->SetEventsFirstRound(fEvents->GetNewIntValue(newVal));
+  } else if (command == fReduction) {
+    fOptimizer->SetReduction(fReduction->GetNewDoubleValue(newVal));
+  } else if (command == fConfidence) {
+    fOptimizer->SetConfidence(fConfidence->GetNewDoubleValue(newVal));
+  } else if (command == fTargetError) {
+    fOptimizer->SetTargetError(fTargetError->GetNewDoubleValue(newVal));
+  } else if (command == fMaxEvents) {
+    fOptimizer->SetMaxEvents(fMaxEvents->GetNewDoubleValue(newVal));
+  } else if (command == fThreshold) {
+    fOptimizer->SetThreshold(fThreshold->GetNewDoubleValue(newVal));
+  } else if (command == fFileName) {
+    fOptimizer->SetFileName(newVal);
+  } else if (command == fNormalization) {
+    fOptimizer->SetNormalization(newVal);
+  } else if (command == fRun) {
+    fOptimizer->Start();
+  }
+}
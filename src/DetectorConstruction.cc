@@ -9,6 +9,8 @@
 #include "G4RunManager.hh"
 #include "G4NistManager.hh"
 #include "G4SDManager.hh"
+#include "G4StateManager.hh"
+#include "G4UImanager.hh"
 
 #include "G4Box.hh"
 #include "G4Tubs.hh"
@@ -25,24 +27,56 @@
 #include "G4UnionSolid.hh"
 #include "G4LogicalVolume.hh"
 #include "G4PVPlacement.hh"
-#include "G4VPrimitiveScorer.hh"
-#include "G4MultiFunctionalDetector.hh"
-#include "G4SDParticleFilter.hh"
-#include "G4PSCellFlux.hh"
-#include "G4PSEnergyDeposit.hh"
+#include "BF3SensitiveDetector.hh"
+#include "XSBiasingOperator.hh"
+#include "DetectorMessenger.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4RegionStore.hh"
+#include "G4Region.hh"
+#include "G4ProductionCuts.hh"
+#include "G4UserLimits.hh"
 
 #include "G4SystemOfUnits.hh"
 #include "G4VisAttributes.hh"
 #define _USE_MATH_DEFINES 
 #include <math.h>
+#include <algorithm>
+#include <cfloat>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
 
 
+namespace {
+  G4ThreadLocal XSBiasingOperator* xsBiasing = 0;
+}
+
 DetectorConstruction::DetectorConstruction()
 : G4VUserDetectorConstruction()
 {
+  // Tube and moderator dimensions, the world follows from them:
+  fTubeDiam = 4.4*cm;
+  fTubeHeight = 10.0*cm;
+  fTubeGap = 0.25*cm;
+  fModX = fTubeDiam*2. + 4.5*cm;
+  fModY = fTubeDiam + 2.*cm;
+  fModZ = fTubeHeight;
+  // Fill gas:
+  fB10Enrichment = 0.96;
+  fGasDensity = 2.73e-3*g/cm3; // From Walker Dissertation
+  fGasPressure = 1.*atmosphere;
+  fGasVersion = 0;
+  // Regions: fine tracking in the gas, only neutron transport matters in
+  // the moderator and the air. Cut, max step, min charged energy:
+  fRegions["Gas"] = {10.*um, 0.5*mm, 0.};
+  fRegions["Shell"] = {0.1*mm, DBL_MAX, 0.};
+  fRegions["Moderator"] = {1.*cm, DBL_MAX, 0.};
+  fRegions["AirSource"] = {10.*cm, DBL_MAX, 0.};
+  fXSBiasFactor = 1.;
+  fBooleanFree = false;
+  fMessenger = new DetectorMessenger(this);
   fmats = {};
   ConstructMaterials();
 }
@@ -51,7 +85,9 @@ DetectorConstruction::DetectorConstruction()
 //
 
 DetectorConstruction::~DetectorConstruction()
-{}
+{
+  delete fMessenger;
+}
 
 //
 //
@@ -87,8 +123,6 @@ void DetectorConstruction::ConstructMaterials()
 
 // Material info from :
 // https://gitlab.cern.ch/clemenci/Geant4-srcs/-/blob/92686251452762ac5947193b5f02ba43b77f546b/examples/extended/hadronic/FissionFragment/src/FFDetectorConstruction.cc
-    G4double const B10Enrichment = 0.96;
-    G4double const B11Enrichment = 0.04;
     G4Isotope* const iB10
         = new G4Isotope("iB10",                         // name
                         5,                              // ZZZ
@@ -113,27 +147,10 @@ void DetectorConstruction::ConstructMaterials()
     B11->AddIsotope(iB11,                               // isotope
                      1.0);                              // abundance
     G4Element* const flouride = nist->FindOrBuildElement("F");
-    // Calculate the mass fractions
-    const G4double BF3MolecularWeight = B10->GetA() * B10Enrichment
-                                        + B11->GetA() * B11Enrichment
-                                        + flouride->GetA() * 3;
-    const G4double B10MassFraction = (B10->GetA() * B10Enrichment)
-                                     / BF3MolecularWeight;
-    const G4double B11MassFraction = (B11->GetA() * B11Enrichment)
-                                     / BF3MolecularWeight;
-    const G4double flourideMassFraction = (flouride->GetA() * 3)
-                                          / BF3MolecularWeight;
-    // create the material and add the elements
-    fmats["enrBF3"] = new G4Material("BF3_96E",                // name
-                              2.73E-3 * (g/cm3),          // density
-                              3, kStateGas, 293.*kelvin, 1.0*atmosphere);                       // number of components
-    fmats["enrBF3"]->AddElement(B10,                           // element
-                         B10MassFraction);              // mass fraction
-    fmats["enrBF3"]->AddElement(B11,                           // element
-                         B11MassFraction);              // mass fraction
-    fmats["enrBF3"]->AddElement(flouride,                      // element
-                         flourideMassFraction);         // mass fraction
-
+    fElB10 = B10;
+    fElB11 = B11;
+    fElF = flouride;
+    BuildGasMaterial();
 
   G4Material* steel = nist->FindOrBuildMaterial("G4_STAINLESS-STEEL");
   fmats["steel"] = steel;
@@ -151,9 +168,9 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   // Params:
   G4double worldX, worldY, worldZ;
 
-  worldX = 18.3*cm; 
-  worldY = 11.4*cm; 
-  worldZ = 11.*cm;
+  worldX = GetWorldSize().x(); 
+  worldY = GetWorldSize().y(); 
+  worldZ = GetWorldSize().z();
   
   // Construction:
   G4Box* solidWorld = new G4Box("World", 0.5*worldX, 0.5*worldY,0.5*worldZ);
@@ -167,9 +184,9 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   G4double modx, mody, modz;
 
   // Tube and moderator dimensions:
-  tubeDiam = 4.4*cm;
-  tubeHeight = 10.0*cm;
-  modx = tubeDiam*2. + 4.5*cm; mody = tubeDiam + 2.*cm; modz = tubeHeight;
+  tubeDiam = fTubeDiam;
+  tubeHeight = fTubeHeight;
+  modx = fModX; mody = fModY; modz = fModZ;
 
   // Construct BF3 Detectors:
   // SS Shells
@@ -187,10 +204,8 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   // BF3 fill gas:
   G4Tubs* bf3GasSolid1 = new G4Tubs("BF3 Gas1", 0, 0.5*(tubeDiam), 0.5*(tubeHeight), 0, 360.*deg);
   G4LogicalVolume* bf3GasLogic1 = new G4LogicalVolume(bf3GasSolid1, fmats["enrBF3"], "BF3 Gas1");
-  new G4PVPlacement(0, G4ThreeVector(tubeDiam*0.5 + 0.25*cm, 0, 0), bf3GasLogic1, "BF3 Gas1", logicWorld, false, 0, checkOverlaps);
   G4Tubs* bf3GasSolid2 = new G4Tubs("BF3 Gas2", 0, 0.5*(tubeDiam), 0.5*(tubeHeight), 0, 360.*deg);
   G4LogicalVolume* bf3GasLogic2 = new G4LogicalVolume(bf3GasSolid2, fmats["enrBF3"], "BF3 Gas2");
-  new G4PVPlacement(0, G4ThreeVector(-(tubeDiam)*0.5 - 0.25*cm, 0, 0), bf3GasLogic2, "BF3 Gas2", logicWorld, false, 0, checkOverlaps);
   G4cout << "BF3 gas volume: " << bf3GasSolid1->GetCubicVolume()/cm3 + bf3GasSolid2->GetCubicVolume()/cm3 << G4endl;
   // Visual Stuff for gas
   G4VisAttributes* gasAttr = new G4VisAttributes(G4Colour(255., 0., 0.)); // red
@@ -198,62 +213,382 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   bf3GasLogic1->SetVisAttributes(gasAttr);
   bf3GasLogic2->SetVisAttributes(gasAttr);
 
-  // Moderator:
-  G4Box* moderatorDummy1 = new G4Box("BF3 Moderator Dummy", 0.5*modx, 0.5*mody, 0.5*modz);
-  G4Tubs* moderatorVoidDummy1 = new G4Tubs("BF3 Moderator Void Dummy", 0, 0.5*(tubeDiam), 0.5*(tubeHeight + 1.*cm), 0, 360.*deg);
-  G4VSolid* bf3ModeratorTemp = new G4SubtractionSolid("Mod Temp", moderatorDummy1, moderatorVoidDummy1, 0, G4ThreeVector((tubeDiam)*0.5 + 0.25*cm, 0, 0));
-  G4VSolid* bf3ModeratorSolid = new G4SubtractionSolid("BF3 Moderator", bf3ModeratorTemp, moderatorVoidDummy1, 0, G4ThreeVector(-(tubeDiam)*0.5 - 0.25*cm, 0, 0));
-  G4LogicalVolume* moderatorBF3Logic = new G4LogicalVolume(bf3ModeratorSolid, fmats["poly"], "ModeratorBF3");
-  new G4PVPlacement(0, G4ThreeVector(0, 0, 0), moderatorBF3Logic, "ModeratorBF3", logicWorld, false, 0, checkOverlaps);
-  G4cout << "Moderator volume: " << bf3ModeratorSolid->GetCubicVolume()/cm3 << G4endl;
-  // Visual Stuff for moderator
+  // Visual Stuff for moderator and air source
   G4VisAttributes* moderatorAttr = new G4VisAttributes(G4Colour()); // white
   moderatorAttr->SetForceSolid(true);
-  moderatorBF3Logic->SetVisAttributes(moderatorAttr);
-
-  // Air Source
-  G4Box* airSourceDummy = new G4Box("AirSourceDummy", (modx + 4.*cm)*0.5, (mody + 4.*cm)*0.5, 0.5*(modz));
-  G4Box* moderatorDummy2 = new G4Box("ModeratorDummy2", 0.5*modx, 0.5*mody, 0.5*(modz + 0.5*cm));
-  G4VSolid* airSource = new G4SubtractionSolid("AirSource", airSourceDummy, moderatorDummy2, 0, G4ThreeVector(0, 0, 0));
-  G4LogicalVolume* airLogic = new G4LogicalVolume(airSource, fmats["air"], "AirSource");
-  new G4PVPlacement(0, G4ThreeVector(0, 0, 0), airLogic, "AirSource", logicWorld, false, 0, checkOverlaps);
-  G4cout << "Air source volume: " << airSource->GetCubicVolume()/cm3 << G4endl;
-  // visual Stuff for Air source
   G4VisAttributes* airAttr = new G4VisAttributes(G4Colour(0., 255., 0.)); // green
   airAttr->SetForceSolid(true);
-  airLogic->SetVisAttributes(airAttr);
+
+  if (!fBooleanFree) {
+    // Gas tubes sit in the world, inside holes cut from the moderator.
+    new G4PVPlacement(0, G4ThreeVector(GetTubeOffset(), 0, 0), bf3GasLogic1, "BF3 Gas1", logicWorld, false, 0, checkOverlaps);
+    new G4PVPlacement(0, G4ThreeVector(-GetTubeOffset(), 0, 0), bf3GasLogic2, "BF3 Gas2", logicWorld, false, 0, checkOverlaps);
+
+    // Moderator:
+    G4Box* moderatorDummy1 = new G4Box("BF3 Moderator Dummy", 0.5*modx, 0.5*mody, 0.5*modz);
+    G4Tubs* moderatorVoidDummy1 = new G4Tubs("BF3 Moderator Void Dummy", 0, 0.5*(tubeDiam), 0.5*(tubeHeight + 1.*cm), 0, 360.*deg);
+    G4VSolid* bf3ModeratorTemp = new G4SubtractionSolid("Mod Temp", moderatorDummy1, moderatorVoidDummy1, 0, G4ThreeVector(GetTubeOffset(), 0, 0));
+    G4VSolid* bf3ModeratorSolid = new G4SubtractionSolid("BF3 Moderator", bf3ModeratorTemp, moderatorVoidDummy1, 0, G4ThreeVector(-GetTubeOffset(), 0, 0));
+    G4LogicalVolume* moderatorBF3Logic = new G4LogicalVolume(bf3ModeratorSolid, fmats["poly"], "ModeratorBF3");
+    new G4PVPlacement(0, G4ThreeVector(0, 0, 0), moderatorBF3Logic, "ModeratorBF3", logicWorld, false, 0, checkOverlaps);
+    G4cout << "Moderator volume: " << bf3ModeratorSolid->GetCubicVolume()/cm3 << G4endl;
+    moderatorBF3Logic->SetVisAttributes(moderatorAttr);
+
+    // Air Source
+    G4Box* airSourceDummy = new G4Box("AirSourceDummy", (modx + 4.*cm)*0.5, (mody + 4.*cm)*0.5, 0.5*(modz));
+    G4Box* moderatorDummy2 = new G4Box("ModeratorDummy2", 0.5*modx, 0.5*mody, 0.5*(modz + 0.5*cm));
+    G4VSolid* airSource = new G4SubtractionSolid("AirSource", airSourceDummy, moderatorDummy2, 0, G4ThreeVector(0, 0, 0));
+    G4LogicalVolume* airLogic = new G4LogicalVolume(airSource, fmats["air"], "AirSource");
+    new G4PVPlacement(0, G4ThreeVector(0, 0, 0), airLogic, "AirSource", logicWorld, false, 0, checkOverlaps);
+    G4cout << "Air source volume: " << airSource->GetCubicVolume()/cm3 << G4endl;
+    airLogic->SetVisAttributes(airAttr);
+  } else {
+    // Same geometry without Boolean solids: World > AirSource box >
+    // moderator box > air holes > gas. Points inside the moderator are
+    // located in its daughters, so /gps/pos/confine AirSource still only
+    // accepts the air shell.
+    G4Box* airSource = new G4Box("AirSource", (modx + 4.*cm)*0.5, (mody + 4.*cm)*0.5, 0.5*(modz));
+    G4LogicalVolume* airLogic = new G4LogicalVolume(airSource, fmats["air"], "AirSource");
+    new G4PVPlacement(0, G4ThreeVector(0, 0, 0), airLogic, "AirSource", logicWorld, false, 0, checkOverlaps);
+    airLogic->SetVisAttributes(airAttr);
+
+    G4Box* bf3ModeratorSolid = new G4Box("BF3 Moderator", 0.5*modx, 0.5*mody, 0.5*modz);
+    G4LogicalVolume* moderatorBF3Logic = new G4LogicalVolume(bf3ModeratorSolid, fmats["poly"], "ModeratorBF3");
+    new G4PVPlacement(0, G4ThreeVector(0, 0, 0), moderatorBF3Logic, "ModeratorBF3", airLogic, false, 0, checkOverlaps);
+    moderatorBF3Logic->SetVisAttributes(moderatorAttr);
+
+    // As the Boolean holes: 1 cm longer than the tubes, cut at the
+    // moderator faces.
+    G4double holeHeight = std::min(modz, tubeHeight + 1.*cm);
+    G4Tubs* holeSolid = new G4Tubs("BF3 Moderator Hole", 0, 0.5*(tubeDiam), 0.5*holeHeight, 0, 360.*deg);
+    G4LogicalVolume* holeLogic1 = new G4LogicalVolume(holeSolid, fmats["air"], "BF3 Moderator Hole1");
+    G4LogicalVolume* holeLogic2 = new G4LogicalVolume(holeSolid, fmats["air"], "BF3 Moderator Hole2");
+    new G4PVPlacement(0, G4ThreeVector(GetTubeOffset(), 0, 0), holeLogic1, "BF3 Moderator Hole1", moderatorBF3Logic, false, 0, checkOverlaps);
+    new G4PVPlacement(0, G4ThreeVector(-GetTubeOffset(), 0, 0), holeLogic2, "BF3 Moderator Hole2", moderatorBF3Logic, false, 0, checkOverlaps);
+    holeLogic1->SetVisAttributes(G4VisAttributes::GetInvisible());
+    holeLogic2->SetVisAttributes(G4VisAttributes::GetInvisible());
+    new G4PVPlacement(0, G4ThreeVector(), bf3GasLogic1, "BF3 Gas1", holeLogic1, false, 0, checkOverlaps);
+    new G4PVPlacement(0, G4ThreeVector(), bf3GasLogic2, "BF3 Gas2", holeLogic2, false, 0, checkOverlaps);
+    G4cout << "Moderator volume: " << bf3ModeratorSolid->GetCubicVolume()/cm3 - 2.*holeSolid->GetCubicVolume()/cm3 << G4endl;
+  }
+
+  // Regions; daughters (e.g. the moderator holes) follow their mother.
+  SetupRegion("Gas", {bf3GasLogic1, bf3GasLogic2});
+  SetupRegion("Shell", {bf3ShellLogic1, bf3ShellLogic2});
+  SetupRegion("Moderator", {G4LogicalVolumeStore::GetInstance()->GetVolume("ModeratorBF3")});
+  SetupRegion("AirSource", {G4LogicalVolumeStore::GetInstance()->GetVolume("AirSource")});
   return physWorld;
 }
 
-void DetectorConstruction::ConstructSDandField()
+//
+//
+
+void DetectorConstruction::SetupRegion(const G4String& name,
+                                       const std::vector<G4LogicalVolume*>& volumes)
 {
-  G4SDParticleFilter* nFilter = new G4SDParticleFilter("NeutronFilter");
-  nFilter->add("alpha");
-  nFilter->addIon(3,7); // Li7
-  nFilter->addIon(3,6); // Li6
-  nFilter->add("proton");
-  nFilter->addIon(4,10); // Be10
-  nFilter->add("deuteron");
-  nFilter->addIon(4,9); // Be9
-  nFilter->add("triton");
-  nFilter->addIon(4, 8); // Be8
-  nFilter->addIon(5,10); // B-10
-  nFilter->addIon(5,11); // B-11
-  nFilter->add("neutron");
+  // Only placed volumes can be region roots; the shells are built but not
+  // placed at the moment, and an empty region is not made.
+  std::vector<G4LogicalVolume*> placed;
+  for (auto pv : *G4PhysicalVolumeStore::GetInstance()) {
+    for (auto lv : volumes) {
+      if (pv->GetLogicalVolume() == lv
+          && std::find(placed.begin(), placed.end(), lv) == placed.end()) placed.push_back(lv);
+    }
+  }
+  if (placed.empty()) return;
+  // The region outlives a geometry reinitialization, its volumes do not.
+  G4Region* region = G4RegionStore::GetInstance()->FindOrCreateRegion(name);
+  for (auto lv : placed) region->AddRootLogicalVolume(lv);
+  ApplyRegionSettings(name);
+}
 
-  
-  G4MultiFunctionalDetector* bf3Detector1 = new G4MultiFunctionalDetector("BF31");
-  G4SDManager::GetSDMpointer()->AddNewDetector(bf3Detector1);
-  G4VPrimitiveScorer* energyDep1 = new G4PSEnergyDeposit("EnergyDep1");
-  bf3Detector1->RegisterPrimitive(energyDep1);
-  energyDep1->SetFilter(nFilter);
+//
+//
+
+void DetectorConstruction::ApplyRegionSettings(const G4String& name)
+{
+  G4Region* region = G4RegionStore::GetInstance()->GetRegion(name, false);
+  if (!region) return;
+  const RegionSettings& settings = fRegions[name];
+  G4ProductionCuts* cuts = region->GetProductionCuts();
+  if (!cuts) {
+    cuts = new G4ProductionCuts();
+    region->SetProductionCuts(cuts);
+  }
+  cuts->SetProductionCut(settings.cut);
+  // Applied to charged particles by G4StepLimiterPhysics.
+  G4UserLimits* limits = region->GetUserLimits();
+  if (!limits) {
+    limits = new G4UserLimits();
+    region->SetUserLimits(limits);
+  }
+  limits->SetMaxAllowedStep(settings.maxStep);
+  limits->SetUserMinEkine(settings.minEkine);
+}
+
+//
+//
+
+G4bool DetectorConstruction::SetRegionCut(const G4String& region, G4double cut)
+{
+  if (fRegions.find(region) == fRegions.end()) return false;
+  fRegions[region].cut = cut;
+  ApplyRegionSettings(region);
+  return true;
+}
+
+//
+//
+
+G4bool DetectorConstruction::SetRegionMaxStep(const G4String& region, G4double step)
+{
+  if (fRegions.find(region) == fRegions.end()) return false;
+  fRegions[region].maxStep = step;
+  ApplyRegionSettings(region);
+  return true;
+}
+
+//
+//
+
+G4bool DetectorConstruction::SetRegionMinEkine(const G4String& region, G4double ekin)
+{
+  if (fRegions.find(region) == fRegions.end()) return false;
+  fRegions[region].minEkine = ekin;
+  ApplyRegionSettings(region);
+  return true;
+}
+
+void DetectorConstruction::BuildGasMaterial()
+{
+    // Enrichment, density and pressure can change at run time. A new
+    // material is made from the same elements every time, so the element
+    // wise neutron data already loaded stay valid.
+    const G4double B10Enrichment = fB10Enrichment;
+    const G4double B11Enrichment = 1. - fB10Enrichment;
+    // Calculate the mass fractions
+    const G4double BF3MolecularWeight = fElB10->GetA() * B10Enrichment
+                                        + fElB11->GetA() * B11Enrichment
+                                        + fElF->GetA() * 3;
+    const G4double B10MassFraction = (fElB10->GetA() * B10Enrichment)
+                                     / BF3MolecularWeight;
+    const G4double B11MassFraction = (fElB11->GetA() * B11Enrichment)
+                                     / BF3MolecularWeight;
+    const G4double flourideMassFraction = (fElF->GetA() * 3)
+                                          / BF3MolecularWeight;
+    G4String name = "BF3_96E";
+    if (fGasVersion > 0) name += "_" + std::to_string(fGasVersion);
+    fGasVersion++;
+    // Elements with zero mass fraction are left out.
+    G4int nComponents = 1 + (B10MassFraction > 0.) + (B11MassFraction > 0.);
+    // create the material and add the elements
+    fmats["enrBF3"] = new G4Material(name,                     // name
+                              fGasDensity,                // density
+                              nComponents, kStateGas, 293.*kelvin, fGasPressure); // number of components
+    if (B10MassFraction > 0.) fmats["enrBF3"]->AddElement(fElB10,  // element
+                         B10MassFraction);              // mass fraction
+    if (B11MassFraction > 0.) fmats["enrBF3"]->AddElement(fElB11,  // element
+                         B11MassFraction);              // mass fraction
+    fmats["enrBF3"]->AddElement(fElF,                          // element
+                         flourideMassFraction);         // mass fraction
+}
+
+//
+//
+
+G4bool DetectorConstruction::DesignFits(G4double tubeDiam, G4double tubeHeight, G4double tubeGap,
+                                        const G4ThreeVector& mod) const
+{
+  // The world is sized from the moderator, so only the tubes can stick out.
+  G4ExceptionDescription msg;
+  if (tubeDiam + tubeGap > 0.5*mod.x()) {
+    msg << "Tube diameter + gap (" << (tubeDiam + tubeGap)/cm
+        << " cm) exceed half the moderator width (" << 0.5*mod.x()/cm << " cm).";
+  } else if (tubeDiam > mod.y()) {
+    msg << "Tube diameter (" << tubeDiam/cm << " cm) exceeds the moderator depth ("
+        << mod.y()/cm << " cm).";
+  } else if (tubeHeight > mod.z()) {
+    msg << "Tube height (" << tubeHeight/cm << " cm) exceeds the moderator height ("
+        << mod.z()/cm << " cm).";
+  } else {
+    return true;
+  }
+  msg << " Command ignored.";
+  G4Exception("DetectorConstruction::DesignFits()", "BF3Det002", JustWarning, msg);
+  return false;
+}
+
+//
+//
+
+G4bool DetectorConstruction::GeometryCanBeModified() const
+{
+  // G4ImportanceProcess keeps the navigator of the importance world it was
+  // set up with, and a full rebuild deletes that world with all the other
+  // volumes; the G4IStore would also point at deleted layers.
+  if (G4StateManager::GetStateManager()->GetCurrentState() != G4State_PreInit
+      && GetNumberOfParallelWorld() > 0) {
+    G4Exception("DetectorConstruction::GeometryCanBeModified()", "BF3Det001", JustWarning,
+                "The geometry cannot be rebuilt with importance biasing (-importance); "
+                "set it before /run/initialize. Command ignored.");
+    return false;
+  }
+  return true;
+}
+
+//
+//
+
+void DetectorConstruction::GeometryHasBeenModified()
+{
+  // Rebuild the geometry if it already exists.
+  if (G4StateManager::GetStateManager()->GetCurrentState() != G4State_PreInit) {
+    G4RunManager::GetRunManager()->ReinitializeGeometry(true);
+  }
+}
+
+//
+//
+
+void DetectorConstruction::GasHasBeenModified()
+{
+  BuildGasMaterial();
+  if (G4StateManager::GetStateManager()->GetCurrentState() != G4State_PreInit) {
+    // The new gas goes into the existing volumes, so the geometry (and an
+    // importance world on top of it) stays as it is.
+    for (const char* name : {"BF3 Gas1", "BF3 Gas2"}) {
+      G4LogicalVolume* gas = G4LogicalVolumeStore::GetInstance()->GetVolume(name, false);
+      if (gas) gas->SetMaterial(fmats["enrBF3"]);
+    }
+    // Only the material-cuts couples of the new gas need new tables.
+    G4UImanager::GetUIpointer()->ApplyCommand("/run/physicsModified");
+  }
+}
+
+//
+//
+
+void DetectorConstruction::SetTubeDiameter(G4double value)
+{
+  if (!GeometryCanBeModified() || !DesignFits(value, fTubeHeight, fTubeGap, GetModeratorSize())) return;
+  fTubeDiam = value;
+  GeometryHasBeenModified();
+}
+
+//
+//
+
+void DetectorConstruction::SetTubeHeight(G4double value)
+{
+  if (!GeometryCanBeModified() || !DesignFits(fTubeDiam, value, fTubeGap, GetModeratorSize())) return;
+  fTubeHeight = value;
+  GeometryHasBeenModified();
+}
+
+//
+//
+
+void DetectorConstruction::SetTubeGap(G4double value)
+{
+  if (!GeometryCanBeModified() || !DesignFits(fTubeDiam, fTubeHeight, value, GetModeratorSize())) return;
+  fTubeGap = value;
+  GeometryHasBeenModified();
+}
+
+//
+//
+
+void DetectorConstruction::SetModeratorSize(const G4ThreeVector& size)
+{
+  if (!GeometryCanBeModified() || !DesignFits(fTubeDiam, fTubeHeight, fTubeGap, size)) return;
+  fModX = size.x();
+  fModY = size.y();
+  fModZ = size.z();
+  GeometryHasBeenModified();
+}
+
+//
+//
+
+void DetectorConstruction::SetB10Enrichment(G4double value)
+{
+  fB10Enrichment = value;
+  GasHasBeenModified();
+}
+
+//
+//
+
+void DetectorConstruction::SetGasDensity(G4double value)
+{
+  fGasDensity = value;
+  GasHasBeenModified();
+}
+
+//
+//
+
+void DetectorConstruction::SetGasPressure(G4double value)
+{
+  fGasPressure = value;
+  GasHasBeenModified();
+}
+
+//
+//
+
+G4String DetectorConstruction::GetSetupDescription() const
+{
+  // Everything that changes the response; the Boolean-free build does not.
+  std::ostringstream setup;
+  setup << std::setprecision(8);
+  setup << "tube " << fTubeDiam/mm << "x" << fTubeHeight/mm << " mm gap " << fTubeGap/mm
+        << " mm moderator " << fModX/mm << "x" << fModY/mm << "x" << fModZ/mm
+        << " mm B10 " << fB10Enrichment << " gas " << fGasDensity/(g/cm3) << " g/cm3 "
+        << fGasPressure/atmosphere << " atm xsbias " << fXSBiasFactor;
+  for (const auto& region : fRegions) {
+    setup << " " << region.first << " " << region.second.cut/mm << "/"
+          << region.second.maxStep/mm << "/" << region.second.minEkine/MeV;
+  }
+  return setup.str();
+}
+
+//
+//
+
+void DetectorConstruction::SetBooleanFree(G4bool flag)
+{
+  if (flag == fBooleanFree || !GeometryCanBeModified()) return;
+  fBooleanFree = flag;
+  GeometryHasBeenModified();
+}
+
+//
+//
+
+void DetectorConstruction::ConstructSDandField()
+{
+  // Called again after a geometry reinitialization; the detectors of this
+  // thread are then reused.
+  G4SDManager* sdMan = G4SDManager::GetSDMpointer();
+  G4VSensitiveDetector* bf3Detector1 = sdMan->FindSensitiveDetector("BF31", false);
+  if (!bf3Detector1) {
+    bf3Detector1 = new BF3SensitiveDetector("BF31", 0);
+    sdMan->AddNewDetector(bf3Detector1);
+  }
   SetSensitiveDetector("BF3 Gas1", bf3Detector1);
 
-  G4MultiFunctionalDetector* bf3Detector2 = new G4MultiFunctionalDetector("BF32");
-  G4SDManager::GetSDMpointer()->AddNewDetector(bf3Detector2);
-  G4VPrimitiveScorer* energyDep2 = new G4PSEnergyDeposit("EnergyDep2");
-  bf3Detector2->RegisterPrimitive(energyDep2);
-  energyDep2->SetFilter(nFilter);
+  G4VSensitiveDetector* bf3Detector2 = sdMan->FindSensitiveDetector("BF32", false);
+  if (!bf3Detector2) {
+    bf3Detector2 = new BF3SensitiveDetector("BF32", 1);
+    sdMan->AddNewDetector(bf3Detector2);
+  }
   SetSensitiveDetector("BF3 Gas2", bf3Detector2);
-  
+
+  // Optional cross-section biasing of the neutron reactions in the gas:
+  if (fXSBiasFactor != 1.) {
+    if (!xsBiasing) xsBiasing = new XSBiasingOperator("neutron", fXSBiasFactor);
+    xsBiasing->AttachTo(G4LogicalVolumeStore::GetInstance()->GetVolume("BF3 Gas1"));
+    xsBiasing->AttachTo(G4LogicalVolumeStore::GetInstance()->GetVolume("BF3 Gas2"));
+  }
 }
\ No newline at end of file
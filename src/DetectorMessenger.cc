@@ -0,0 +1,182 @@
+// Source code for DetectorMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file DetectorMessenger.cc
+/// \file Source code for DetectorMessenger class.
+
+#include "DetectorConstruction.hh"
+#include "DetectorMessenger.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWith3VectorAndUnit.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
+
+DetectorMessenger::DetectorMessenger(DetectorConstruction* myDetector)
+: G4UImessenger(), fDetector(myDetector)
+{
+  fDetDir = new G4UIdirectory("/BF3/det/");
+  fDetDir->SetGuidance("Control parameters set within DetectorConstruction.");
+
+  fBooleanFree = new G4UIcmdWithABool("/BF3/det/booleanFree", this);
+  fBooleanFree->SetGuidance("Build the moderator from a plain box with the holes and tubes");
+  fBooleanFree->SetGuidance("as daughter volumes instead of Boolean solids.");
+  fBooleanFree->SetParameterName("flag", false);
+  fBooleanFree->AvailableForStates(G4State_PreInit, G4State_Idle);
+  // The detector construction only lives on the master.
+  fBooleanFree->SetToBeBroadcasted(false);
+
+  // Design parameters. Changing them between runs rebuilds only the
+  // geometry; the physics tables are kept.
+  fTubeDiam = new G4UIcmdWithADoubleAndUnit("/BF3/det/tubeDiameter", this);
+  fTubeDiam->SetGuidance("Outer diameter of the BF3 tubes.");
+  fTubeDiam->SetParameterName("diameter", false);
+  fTubeDiam->SetRange("diameter>0.");
+  fTubeDiam->SetDefaultUnit("cm");
+  fTubeDiam->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fTubeDiam->SetToBeBroadcasted(false);
+
+  fTubeHeight = new G4UIcmdWithADoubleAndUnit("/BF3/det/tubeHeight", this);
+  fTubeHeight->SetGuidance("Height of the BF3 tubes.");
+  fTubeHeight->SetParameterName("height", false);
+  fTubeHeight->SetRange("height>0.");
+  fTubeHeight->SetDefaultUnit("cm");
+  fTubeHeight->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fTubeHeight->SetToBeBroadcasted(false);
+
+  fTubeGap = new G4UIcmdWithADoubleAndUnit("/BF3/det/tubeGap", this);
+  fTubeGap->SetGuidance("Distance between the two tubes' walls and the moderator center.");
+  fTubeGap->SetParameterName("gap", false);
+  fTubeGap->SetRange("gap>=0.");
+  fTubeGap->SetDefaultUnit("cm");
+  fTubeGap->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fTubeGap->SetToBeBroadcasted(false);
+
+  fModSize = new G4UIcmdWith3VectorAndUnit("/BF3/det/moderatorSize", this);
+  fModSize->SetGuidance("Full x, y and z size of the moderator block.");
+  fModSize->SetGuidance("The world is resized around it.");
+  fModSize->SetParameterName("x", "y", "z", false);
+  fModSize->SetRange("x>0. && y>0. && z>0.");
+  fModSize->SetDefaultUnit("cm");
+  fModSize->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fModSize->SetToBeBroadcasted(false);
+
+  // Fill gas. Changing it between runs also rebuilds the physics tables of
+  // the new material.
+  fEnrichment = new G4UIcmdWithADouble("/BF3/det/enrichment", this);
+  fEnrichment->SetGuidance("Atom fraction of B-10 in the BF3 fill gas.");
+  fEnrichment->SetParameterName("fraction", false);
+  fEnrichment->SetRange("fraction>=0. && fraction<=1.");
+  fEnrichment->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fEnrichment->SetToBeBroadcasted(false);
+
+  fGasDensity = new G4UIcmdWithADoubleAndUnit("/BF3/det/gasDensity", this);
+  fGasDensity->SetGuidance("Density of the BF3 fill gas.");
+  fGasDensity->SetParameterName("density", false);
+  fGasDensity->SetRange("density>0.");
+  fGasDensity->SetUnitCategory("Volumic Mass");
+  fGasDensity->SetDefaultUnit("g/cm3");
+  fGasDensity->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fGasDensity->SetToBeBroadcasted(false);
+
+  fGasPressure = new G4UIcmdWithADoubleAndUnit("/BF3/det/gasPressure", this);
+  fGasPressure->SetGuidance("Pressure of the BF3 fill gas.");
+  fGasPressure->SetParameterName("pressure", false);
+  fGasPressure->SetRange("pressure>0.");
+  fGasPressure->SetUnitCategory("Pressure");
+  fGasPressure->SetDefaultUnit("atmosphere");
+  fGasPressure->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fGasPressure->SetToBeBroadcasted(false);
+
+  // Regions. The cuts and limits are picked up at the next run; for the
+  // EM options of a region use e.g. /process/em/deexcitation Gas true false false.
+  fRegionCut = MakeRegionCommand("/BF3/det/regionCut", "mm");
+  fRegionCut->SetGuidance("Production cut for gammas, e-, e+ and protons in a region.");
+  fRegionMaxStep = MakeRegionCommand("/BF3/det/regionMaxStep", "mm");
+  fRegionMaxStep->SetGuidance("Maximum step of charged particles in a region.");
+  fRegionMinEkine = MakeRegionCommand("/BF3/det/regionMinEkine", "MeV");
+  fRegionMinEkine->SetGuidance("Charged particles below this kinetic energy are stopped");
+  fRegionMinEkine->SetGuidance("in a region and deposit their energy there.");
+}
+
+//
+//
+
+G4UIcommand* DetectorMessenger::MakeRegionCommand(const G4String& path, const G4String& unit)
+{
+  G4UIcommand* command = new G4UIcommand(path, this);
+  G4UIparameter* region = new G4UIparameter("region", 's', false);
+  region->SetParameterCandidates("Gas Shell Moderator AirSource");
+  command->SetParameter(region);
+  G4UIparameter* value = new G4UIparameter("value", 'd', false);
+  value->SetParameterRange("value>=0.");
+  command->SetParameter(value);
+  G4UIparameter* unitPar = new G4UIparameter("unit", 's', true);
+  unitPar->SetDefaultValue(unit);
+  command->SetParameter(unitPar);
+  command->AvailableForStates(G4State_PreInit, G4State_Idle);
+  command->SetToBeBroadcasted(false);
+  return command;
+}
+
+//
+//
+
+DetectorMessenger::~DetectorMessenger()
+{
+  delete fBooleanFree;
+  delete fTubeDiam;
+  delete fTubeHeight;
+  delete fTubeGap;
+  delete fModSize;
+  delete fEnrichment;
+  delete fGasDensity;
+  delete fGasPressure;
+  delete fRegionCut;
+  delete fRegionMaxStep;
+  delete fRegionMinEkine;
+  delete fDetDir;
+}
+
+//
+//
+
+void DetectorMessenger::SetNewValue(G4UIcommand* command, G4String newVal)
+{
+  if (command == fBooleanFree) {
+    fDetector->SetBooleanFree(fBooleanFree->GetNewBoolValue(newVal));
+  } else if (command == fTubeDiam) {
+    fDetector->SetTubeDiameter(fTubeDiam->GetNewDoubleValue(newVal));
+  } else if (command == fTubeHeight) {
+    fDetector->SetTubeHeight(fTubeHeight->GetNewDoubleValue(newVal));
+  } else if (command == fTubeGap) {
+    fDetector->SetTubeGap(fTubeGap->GetNewDoubleValue(newVal));
+  } else if (command == fModSize) {
+    fDetector->SetModeratorSize(fModSize->GetNew3VectorValue(newVal));
+  } else if (command == fEnrichment) {
+    fDetector->SetB10Enrichment(fEnrichment->GetNewDoubleValue(newVal));
+  } else if (command == fGasDensity) {
+    fDetector->SetGasDensity(fGasDensity->GetNewDoubleValue(newVal));
+  } else if (command == fGasPressure) {
+    fDetector->SetGasPressure(fGasPressure->GetNewDoubleValue(newVal));
+  } else if (command == fRegionCut || command == fRegionMaxStep
+             || command == fRegionMinEkine) {
+    G4String region, unit;
+    G4double value;
+    std::istringstream is(newVal);
+    is >> region >> value >> unit;
+    value *= G4UIcommand::ValueOf(unit);
+    if (command == fRegionCut) {
+      fDetector->SetRegionCut(region, value);
+    } else if (command == fRegionMaxStep) {
+      fDetector->SetRegionMaxStep(region, value);
+    } else {
+      fDetector->SetRegionMinEkine(region, value);
+    }
+  }
+}
@@ -0,0 +1,67 @@
+// Source code for ImportanceMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file ImportanceMessenger.cc
+/// \file Source code for ImportanceMessenger class.
+
+#include "ImportanceWorld.hh"
+#include "ImportanceMessenger.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithADouble.hh"
+
+#include <sstream>
+
+ImportanceMessenger::ImportanceMessenger(ImportanceWorld* myImportanceWorld)
+: G4UImessenger(), fImportanceWorld(myImportanceWorld)
+{
+  fImpDir = new G4UIdirectory("/BF3/importance/");
+  fImpDir->SetGuidance("Geometry importance biasing (start bf3 with -importance).");
+
+  fValue = new G4UIcommand("/BF3/importance/value", this);
+  fValue->SetGuidance("Set the importance of one layer (0 is the world, the highest");
+  fValue->SetGuidance("layer encloses the tubes).");
+  G4UIparameter* layer = new G4UIparameter("layer", 'i', false);
+  layer->SetParameterRange("layer>=0");
+  fValue->SetParameter(layer);
+  G4UIparameter* importance = new G4UIparameter("importance", 'd', false);
+  importance->SetParameterRange("importance>0.");
+  fValue->SetParameter(importance);
+  fValue->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fValue->SetToBeBroadcasted(false);
+
+  fBase = new G4UIcmdWithADouble("/BF3/importance/base", this);
+  fBase->SetGuidance("Set the importance of layer i to base^i.");
+  fBase->SetParameterName("base", false);
+  fBase->SetRange("base>0.");
+  fBase->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fBase->SetToBeBroadcasted(false);
+}
+
+//
+//
+
+ImportanceMessenger::~ImportanceMessenger()
+{
+  delete fValue;
+  delete fBase;
+  delete fImpDir;
+}
+
+//
+//
+
+void ImportanceMessenger::SetNewValue(G4UIcommand* command, G4String newVal)
+{
+  if (command == fValue) {
+    G4int layer;
+    G4double importance;
+    std::istringstream is(newVal);
+    is >> layer >> importance;
+    fImportanceWorld->SetImportance(layer, importance);
+  } else if (command == fBase) {
+    fImportanceWorld->SetImportanceBase(fBase->GetNewDoubleValue(newVal));
+  }
+}
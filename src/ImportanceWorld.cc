@@ -0,0 +1,110 @@
+// Source code for ImportanceWorld().
+// Created by agent on October 17, 2026.
+
+/// \file ImportanceWorld.cc
+/// \brief Source code for ImportanceWorld class.
+
+#include "ImportanceWorld.hh"
+#include "ImportanceMessenger.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4IStore.hh"
+#include "G4GeometryCell.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+
+ImportanceWorld::ImportanceWorld(const G4String& worldName, const DetectorConstruction* detector, G4int nLayers)
+: G4VUserParallelWorld(worldName), fDetector(detector), fNLayers(nLayers), fGhostWorld(0)
+{
+  fImportances.assign(fNLayers + 1, 1.);
+  SetImportanceBase(2.);
+  fMessenger = new ImportanceMessenger(this);
+}
+
+//
+//
+
+ImportanceWorld::~ImportanceWorld()
+{
+  delete fMessenger;
+}
+
+//
+//
+
+void ImportanceWorld::Construct()
+{
+  fGhostWorld = GetWorld();
+  fLayers.clear();
+  fLayers.push_back(fGhostWorld);
+
+  // Outermost layer sits half way between the AirSource shell and the world
+  // boundary, the innermost one just encloses both tubes.
+  G4ThreeVector world = 0.5*fDetector->GetWorldSize();
+  G4ThreeVector mod = 0.5*fDetector->GetModeratorSize();
+  G4ThreeVector air(mod.x() + 2.*cm, mod.y() + 2.*cm, mod.z());
+  G4ThreeVector outer = 0.5*(world + air);
+  outer.setZ(world.z() - 0.1*cm);
+  G4double tubeR = 0.5*fDetector->GetTubeDiameter();
+  G4ThreeVector inner(fDetector->GetTubeOffset() + tubeR + 0.05*cm, tubeR + 0.05*cm,
+                      0.5*fDetector->GetTubeHeight() + 0.05*cm);
+
+  G4LogicalVolume* mother = fGhostWorld->GetLogicalVolume();
+  for (G4int i = 1; i <= fNLayers; i++) {
+    G4double t = (fNLayers > 1) ? G4double(i - 1)/(fNLayers - 1) : 0.;
+    G4ThreeVector half = outer + t*(inner - outer);
+    G4String name = "ImportanceLayer" + std::to_string(i);
+    G4Box* solid = new G4Box(name, half.x(), half.y(), half.z());
+    // Ghost volumes carry no material.
+    G4LogicalVolume* logic = new G4LogicalVolume(solid, 0, name);
+    fLayers.push_back(new G4PVPlacement(0, G4ThreeVector(), logic, name, mother, false, i, false));
+    mother = logic;
+  }
+}
+
+//
+//
+
+void ImportanceWorld::CreateImportanceStore()
+{
+  G4IStore* iStore = G4IStore::GetInstance(GetName());
+  for (size_t i = 0; i < fLayers.size(); i++) {
+    // G4ImportanceProcess looks cells up by replica number, which for a
+    // placement is its copy number, i for layer i (as in example B01).
+    iStore->AddImportanceGeometryCell(fImportances[i], *fLayers[i], i);
+  }
+}
+
+//
+//
+
+void ImportanceWorld::SetImportance(G4int layer, G4double importance)
+{
+  if (layer < 0 || layer > fNLayers) {
+    G4Exception("ImportanceWorld::SetImportance()", "BF3Imp001", JustWarning,
+                "No such importance layer, command ignored.");
+    return;
+  }
+  fImportances[layer] = importance;
+  // Once the store exists, importances can still be changed between runs.
+  if (layer < G4int(fLayers.size())) {
+    G4IStore* iStore = G4IStore::GetInstance(GetName());
+    if (iStore->IsKnown(G4GeometryCell(*fLayers[layer], layer))) {
+      iStore->ChangeImportance(importance, *fLayers[layer], layer);
+    }
+  }
+}
+
+//
+//
+
+void ImportanceWorld::SetImportanceBase(G4double base)
+{
+  for (G4int i = 0; i <= fNLayers; i++) {
+    SetImportance(i, std::pow(base, i));
+  }
+}
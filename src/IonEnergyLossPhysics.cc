@@ -0,0 +1,59 @@
+// Source code for IonEnergyLossPhysics().
+// Created by agent on October 17, 2026.
+
+/// \file IonEnergyLossPhysics.cc
+/// \brief Implementation of the IonEnergyLossPhysics class
+
+#include "IonEnergyLossPhysics.hh"
+
+#include "G4PhysicsListHelper.hh"
+#include "G4Proton.hh"
+#include "G4Deuteron.hh"
+#include "G4Triton.hh"
+#include "G4He3.hh"
+#include "G4Alpha.hh"
+#include "G4GenericIon.hh"
+
+#include "G4hMultipleScattering.hh"
+#include "G4hIonisation.hh"
+#include "G4ionIonisation.hh"
+#include "G4NuclearStopping.hh"
+
+//
+//
+
+IonEnergyLossPhysics::IonEnergyLossPhysics(const G4String& name)
+:  G4VPhysicsConstructor(name)
+{}
+
+//
+//
+
+IonEnergyLossPhysics::~IonEnergyLossPhysics()
+{}
+
+//
+//
+
+void IonEnergyLossPhysics::ConstructProcess()
+{
+  G4PhysicsListHelper* ph = G4PhysicsListHelper::GetPhysicsListHelper();
+
+  // Hydrogen isotopes: proton recoils in the moderator, 3He(n,p)t products.
+  G4ParticleDefinition* hydrogens[] = {G4Proton::Proton(), G4Deuteron::Deuteron(),
+                                       G4Triton::Triton()};
+  for (auto particle : hydrogens) {
+    ph->RegisterProcess(new G4hMultipleScattering(), particle);
+    ph->RegisterProcess(new G4hIonisation(), particle);
+  }
+
+  // Alphas, 7Li and the recoil ions: effective charge and nuclear stopping
+  // matter at the end of their short range.
+  G4ParticleDefinition* ions[] = {G4He3::He3(), G4Alpha::Alpha(),
+                                  G4GenericIon::GenericIon()};
+  for (auto particle : ions) {
+    ph->RegisterProcess(new G4hMultipleScattering("ionmsc"), particle);
+    ph->RegisterProcess(new G4ionIonisation(), particle);
+    ph->RegisterProcess(new G4NuclearStopping(), particle);
+  }
+}
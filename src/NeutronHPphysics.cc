@@ -35,6 +35,7 @@
 //#include "NeutronHPMessenger.hh"
 
 #include "G4ParticleDefinition.hh"
+#include "G4Neutron.hh"
 #include "G4ProcessManager.hh"
 #include "G4ProcessTable.hh"
 
@@ -45,17 +46,16 @@
 #include "G4ParticleHPThermalScatteringData.hh"
 #include "G4ParticleHPElastic.hh"
 #include "G4ParticleHPThermalScattering.hh"
-#include "G4HadronElastic.hh"
-//#include "G4HadronElasticDataSet.hh"
-//#include "G4NeutronInelasticProcess.hh"
+
+#include "G4HadronInelasticProcess.hh"
 #include "G4ParticleHPInelasticData.hh"
 #include "G4ParticleHPInelastic.hh"
 
-//#include "G4HadronCaptureProcess.hh"
+#include "G4NeutronCaptureProcess.hh"
 #include "G4ParticleHPCaptureData.hh"
 #include "G4ParticleHPCapture.hh"
 
-///#include "G4HadronFissionProcess.hh"
+#include "G4NeutronFissionProcess.hh"
 #include "G4ParticleHPFissionData.hh"
 #include "G4ParticleHPFission.hh"
 
@@ -80,28 +80,21 @@ NeutronHPphysics::~NeutronHPphysics()
 
 void NeutronHPphysics::ConstructProcess()
 {
+  // High precision models only, so neutrons are only transported below
+  // 20 MeV; that covers the BUGLE-96 groups.
   G4ParticleDefinition* neutron = G4Neutron::Neutron();
   G4ProcessManager* pManager = neutron->GetProcessManager();
    
   // delete all neutron processes if already registered
   //
-  G4VProcess* process = 0;
-  process = pManager->GetProcess("hadElastic");
-  if (process) pManager->RemoveProcess(process);
-  //
-  /*
-  process = pManager->GetProcess("neutronInelastic");
-  if (process) pManager->RemoveProcess(process);
-  //
-  process = pManager->GetProcess("nCapture");      
-  if (process) pManager->RemoveProcess(process);
-  //
-  process = pManager->GetProcess("nFission");      
-  if (process) pManager->RemoveProcess(process);      
-  */
+  const char* names[] = {"hadElastic", "neutronInelastic", "nCapture", "nFission"};
+  for (auto name : names) {
+    G4VProcess* process = pManager->GetProcess(name);
+    if (process) pManager->RemoveProcess(process);
+  }
+
   // (re) create process: elastic
   //
-  /*
   G4HadronElasticProcess* process1 = new G4HadronElasticProcess();
   pManager->AddDiscreteProcess(process1);
   //
@@ -110,22 +103,18 @@ void NeutronHPphysics::ConstructProcess()
   process1->RegisterMe(model1a);
   process1->AddDataSet(new G4ParticleHPElasticData());
   //
-  // model1b
+  // model1b: S(alpha,beta) below 4 eV, e.g. H in G4_POLYETHYLENE
   if (fThermal) {
     model1a->SetMinEnergy(4*eV);   
-   G4ParticleHPThermalScattering* model1b = new G4ParticleHPThermalScattering();
+    G4ParticleHPThermalScattering* model1b = new G4ParticleHPThermalScattering();
     process1->RegisterMe(model1b);
     process1->AddDataSet(new G4ParticleHPThermalScatteringData());
   }
-  G4HadronElastic* model1c = new G4HadronElastic();
-  model1c->SetMinEnergy(19.5*MeV);
-  process1->RegisterMe(model1c);
-  process1->AddDataSet(new G4HadronElasticDataSet());
-  */
-  /*
-  // (re) create process: inelastic
+
+  // (re) create process: inelastic, 10B(n,alpha) is in here
   //
-  G4NeutronInelasticProcess* process2 = new G4NeutronInelasticProcess();
+  G4HadronInelasticProcess* process2 =
+    new G4HadronInelasticProcess("neutronInelastic", neutron);
   pManager->AddDiscreteProcess(process2);   
   //
   // cross section data set
@@ -138,7 +127,7 @@ void NeutronHPphysics::ConstructProcess()
 
   // (re) create process: nCapture   
   //
-  G4HadronCaptureProcess* process3 = new G4HadronCaptureProcess();
+  G4NeutronCaptureProcess* process3 = new G4NeutronCaptureProcess();
   pManager->AddDiscreteProcess(process3);    
   //
   // cross section data set
@@ -151,7 +140,7 @@ void NeutronHPphysics::ConstructProcess()
    
   // (re) create process: nFission   
   //
-  G4HadronFissionProcess* process4 = new G4HadronFissionProcess();
+  G4NeutronFissionProcess* process4 = new G4NeutronFissionProcess();
   pManager->AddDiscreteProcess(process4);
   //
   // cross section data set
@@ -161,7 +150,6 @@ void NeutronHPphysics::ConstructProcess()
   // models
   G4ParticleHPFission* model4 = new G4ParticleHPFission();
   process4->RegisterMe(model4);
-  */
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -54,9 +54,14 @@
 #include "G4IonConstructor.hh"
 #include "G4ShortLivedConstructor.hh"
 #include "NeutronHPphysics.hh"
+#include "IonEnergyLossPhysics.hh"
+#include "PhysicsListMessenger.hh"
+
+#include <algorithm>
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-PhysicsList::PhysicsList()
+PhysicsList::PhysicsList(const G4String& mode)
 :G4VModularPhysicsList()
 {
   G4int verb = 1;  
@@ -68,10 +73,81 @@ PhysicsList::PhysicsList()
   new G4UnitDefinition( "mm2/g",  "mm2/g", "Surface/Mass", mm2/g);
   new G4UnitDefinition( "um2/mg", "um2/mg","Surface/Mass", um*um/mg);  
   
+  RegisterMode(mode);
+  fMessenger = new PhysicsListMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsList::SetMode(const G4String& mode)
+{
+  if (mode == fMode) return;
+  // Constructors registered from outside keep their place after the mode.
+  std::vector<G4VPhysicsConstructor*> others;
+  for (G4int i = 0; GetPhysics(i); i++) {
+    G4VPhysicsConstructor* physics = const_cast<G4VPhysicsConstructor*>(GetPhysics(i));
+    if (std::find(fModePhysics.begin(), fModePhysics.end(), physics) == fModePhysics.end()) {
+      others.push_back(physics);
+    }
+  }
+  for (auto physics : fModePhysics) {
+    RemovePhysics(physics);
+    delete physics;
+  }
+  fModePhysics.clear();
+  for (auto physics : others) RemovePhysics(physics);
+  RegisterMode(mode);
+  for (auto physics : others) RegisterPhysics(physics);
+  G4cout << "Physics list: " << fMode << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsList::RegisterModePhysics(G4VPhysicsConstructor* physics)
+{
+  RegisterPhysics(physics);
+  fModePhysics.push_back(physics);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhysicsList::RegisterMode(const G4String& mode)
+{
+  G4int verb = 1;
+  fMode = mode;
+
+  if (mode == "qgsp") {
+    // Same constructors as QGSP_BIC_AllHP:
+    RegisterModePhysics( new G4EmStandardPhysics_option4(verb));
+    RegisterModePhysics( new G4EmExtraPhysics(verb));
+    RegisterModePhysics( new G4DecayPhysics(verb));
+    RegisterModePhysics( new G4RadioactiveDecayPhysics(verb));
+    RegisterModePhysics( new G4HadronElasticPhysicsPHP(verb));
+    RegisterModePhysics( new G4HadronPhysicsQGSP_BIC_AllHP(verb));
+    RegisterModePhysics( new G4StoppingPhysics(verb));
+    RegisterModePhysics( new G4IonPhysicsPHP(verb));
+    RegisterModePhysics( new G4IonElasticPhysics(verb));
+    // S(alpha,beta) for the polyethylene, after the elastic physics.
+    RegisterModePhysics( new G4ThermalNeutrons(verb));
+    return;
+  } else if (mode == "bf3response") {
+    // Neutron HP with S(alpha,beta) for H in polyethylene:
+    RegisterModePhysics( new NeutronHPphysics("neutronHP"));
+    // Ion energy loss in the gas:
+    RegisterModePhysics( new IonEnergyLossPhysics());
+    // Free neutron and unstable particle decays, as in the other lists:
+    RegisterModePhysics( new G4DecayPhysics(verb));
+    return;
+  } else if (mode != "hadr03") {
+    G4ExceptionDescription msg;
+    msg << "Unknown physics list mode \"" << mode << "\", use qgsp, hadr03 or bf3response.";
+    G4Exception("PhysicsList::RegisterMode()", "BF3Phys001", FatalException, msg);
+  }
+
   // Hadron Elastic scattering
   //
   //
-  RegisterPhysics( new G4HadronElasticPhysicsLEND(verb));
+  RegisterModePhysics( new G4HadronElasticPhysicsLEND(verb));
   //RegisterPhysics( new NeutronHPphysics("neutronHP"));
   
   // Hadron Inelastic physics
@@ -84,21 +160,21 @@ PhysicsList::PhysicsList()
   ////RegisterPhysics( new G4HadronInelasticQBBC(verb));
   ////RegisterPhysics( new G4HadronPhysicsINCLXX(verb));
   //RegisterPhysics( new G4HadronPhysicsShieldingLEND(verb));
-  RegisterPhysics( new G4HadronPhysicsQGSP_BIC_AllHP());
-  RegisterPhysics( new G4ThermalNeutrons(verb));  
+  RegisterModePhysics( new G4HadronPhysicsQGSP_BIC_AllHP());
+  RegisterModePhysics( new G4ThermalNeutrons(verb));  
   // Electromagnetic physics:
-  RegisterPhysics( new G4EmStandardPhysics_option4(verb));
-  RegisterPhysics( new G4EmExtraPhysics(verb));
+  RegisterModePhysics( new G4EmStandardPhysics_option4(verb));
+  RegisterModePhysics( new G4EmExtraPhysics(verb));
   
   // Ion Elastic scattering
   //
-  RegisterPhysics( new G4IonElasticPhysics(verb));
+  RegisterModePhysics( new G4IonElasticPhysics(verb));
   
   // Ion Inelastic physics
   //
   ///RegisterPhysics( new G4IonPhysicsXS(verb));
-  RegisterPhysics( new G4IonPhysicsPHP(verb));
-  RegisterPhysics( new G4StoppingPhysics(verb));
+  RegisterModePhysics( new G4IonPhysicsPHP(verb));
+  RegisterModePhysics( new G4StoppingPhysics(verb));
   ////RegisterPhysics( new G4IonQMDPhysics(verb));
   ////RegisterPhysics( new G4IonINCLXXPhysics(verb));
 
@@ -107,14 +183,16 @@ PhysicsList::PhysicsList()
   //RegisterPhysics( new GammaNuclearPhysics("gamma"));
   
   // Radioactive decay
-  RegisterPhysics(new G4RadioactiveDecayPhysics());
-  RegisterPhysics(new G4DecayPhysics());
+  RegisterModePhysics(new G4RadioactiveDecayPhysics());
+  RegisterModePhysics(new G4DecayPhysics());
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 PhysicsList::~PhysicsList()
-{ }
+{
+  delete fMessenger;
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -0,0 +1,49 @@
+// Source code for PhysicsListMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file PhysicsListMessenger.cc
+/// \file Source code for PhysicsListMessenger class.
+
+#include "PhysicsList.hh"
+#include "PhysicsListMessenger.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+
+PhysicsListMessenger::PhysicsListMessenger(PhysicsList* myPhysicsList)
+: G4UImessenger(), fPhysicsList(myPhysicsList)
+{
+  fPhysDir = new G4UIdirectory("/BF3/phys/");
+  fPhysDir->SetGuidance("Physics list selection.");
+
+  fList = new G4UIcmdWithAString("/BF3/phys/list", this);
+  fList->SetGuidance("Physics list, like -physics on the command line:");
+  fList->SetGuidance("  qgsp:        QGSP_BIC_AllHP + G4ThermalNeutrons (reference)");
+  fList->SetGuidance("  hadr03:      the list of example Hadr03");
+  fList->SetGuidance("  bf3response: HP neutrons, ion energy loss and decays only");
+  fList->SetGuidance("Only before /run/initialize, e.g. in init.mac.");
+  fList->SetParameterName("list", false);
+  fList->SetCandidates("qgsp hadr03 bf3response");
+  fList->AvailableForStates(G4State_PreInit);
+  // The workers share the list of the master.
+  fList->SetToBeBroadcasted(false);
+}
+
+//
+//
+
+PhysicsListMessenger::~PhysicsListMessenger()
+{
+  delete fList;
+  delete fPhysDir;
+}
+
+//
+//
+
+void PhysicsListMessenger::SetNewValue(G4UIcommand* command, G4String newVal)
+{
+  if (command == fList) {
+    fPhysicsList->SetMode(newVal);
+  }
+}
@@ -0,0 +1,209 @@
+// Source code for PhysicsTableCache().
+// Created by agent on October 17, 2026.
+
+/// \file PhysicsTableCache.cc
+/// \brief Source code for PhysicsTableCache class.
+
+#include "PhysicsTableCache.hh"
+
+#include "G4VUserPhysicsList.hh"
+#include "G4VModularPhysicsList.hh"
+#include "G4StateManager.hh"
+#include "G4Material.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
+#include "G4TransportationManager.hh"
+#include "G4Navigator.hh"
+#include "G4EmParameters.hh"
+#include "G4Version.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+  // 64 bit FNV-1a, names the directory of a key.
+  G4String Hash(const G4String& text)
+  {
+    std::uint64_t sum = 14695981039346656037ULL;
+    for (char c : text) {
+      sum ^= static_cast<unsigned char>(c);
+      sum *= 1099511628211ULL;
+    }
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << sum;
+    return name.str();
+  }
+
+  // The tables are plain files in one directory.
+  void RemoveDirectory(const G4String& dir)
+  {
+    DIR* d = opendir(dir.c_str());
+    if (d) {
+      while (dirent* entry = readdir(d)) {
+        G4String name = entry->d_name;
+        if (name != "." && name != "..") std::remove((dir + "/" + name).c_str());
+      }
+      closedir(d);
+    }
+    rmdir(dir.c_str());
+  }
+
+}
+
+PhysicsTableCache::PhysicsTableCache(const G4String& directory, const G4String& physicsSetup,
+                                     G4VUserPhysicsList* physicsList)
+: G4VStateDependent(), fDirectory(directory), fPhysicsSetup(physicsSetup),
+  fPhysicsList(physicsList), fStage(kWaiting), fRetrieved(false)
+{}
+
+//
+//
+
+PhysicsTableCache::~PhysicsTableCache()
+{}
+
+//
+//
+
+G4bool PhysicsTableCache::Notify(G4ApplicationState requestedState)
+{
+  // Called before the state changes, so the current state is the old one.
+  G4ApplicationState state = G4StateManager::GetStateManager()->GetCurrentState();
+  if (fStage == kWaiting && state == G4State_Idle && requestedState == G4State_Init) {
+    // A run (or a geometry rebuild before it) is set up; the last one of
+    // these before the tables are built decides.
+    Lookup();
+  } else if (fStage == kWaiting && state == G4State_Idle && requestedState == G4State_GeomClosed) {
+    // The first run has its tables, the workers have not started yet.
+    if (!fRetrieved) Store();
+    fStage = kFirstRun;
+  } else if (fStage == kFirstRun && state == G4State_GeomClosed && requestedState == G4State_Idle) {
+    // Later rebuilds (new materials or cuts) must not read the cache.
+    fPhysicsList->ResetPhysicsTableRetrieved();
+    fStage = kDone;
+  }
+  return true;
+}
+
+//
+//
+
+G4String PhysicsTableCache::MakeKey() const
+{
+  std::ostringstream key;
+  key << std::setprecision(17);
+  key << "version " << G4Version << std::endl;
+  // Data set paths carry their version numbers.
+  const char* dataSets[] = {"G4LEDATA", "G4LEVELGAMMADATA", "G4PARTICLEXSDATA",
+                            "G4NEUTRONHPDATA", "G4ENSDFSTATEDATA", "G4SAIDXSDATA"};
+  for (auto name : dataSets) {
+    const char* path = std::getenv(name);
+    key << name << " " << (path ? path : "") << std::endl;
+  }
+  key << "physics " << fPhysicsSetup << std::endl;
+  // The constructors, which /BF3/phys/list may have changed.
+  G4VModularPhysicsList* modularList = dynamic_cast<G4VModularPhysicsList*>(fPhysicsList);
+  if (modularList) {
+    key << "constructors";
+    for (G4int i = 0; modularList->GetPhysics(i); i++) {
+      key << " " << modularList->GetPhysics(i)->GetPhysicsName();
+    }
+    key << std::endl;
+  }
+  key << "defaultCut " << fPhysicsList->GetDefaultCutValue()/mm << std::endl;
+  G4EmParameters::Instance()->StreamInfo(key);
+  // Materials by region, as the couples will be made from them.
+  G4VPhysicalVolume* world = G4TransportationManager::GetTransportationManager()
+                               ->GetNavigatorForTracking()->GetWorldVolume();
+  if (world) G4RegionStore::GetInstance()->UpdateMaterialList(world);
+  for (auto region : *G4RegionStore::GetInstance()) {
+    key << "region " << region->GetName();
+    G4ProductionCuts* cuts = region->GetProductionCuts();
+    for (G4int i = 0; cuts && i < NumberOfG4CutIndex; i++) {
+      key << " " << cuts->GetProductionCut(i)/mm;
+    }
+    for (auto material = region->GetMaterialIterator();
+         material != region->GetMaterialIterator() + region->GetNumberOfMaterials(); material++) {
+      key << " " << (*material)->GetName();
+    }
+    key << std::endl;
+  }
+  for (auto material : *G4Material::GetMaterialTable()) {
+    key << "material " << material->GetName() << " " << material->GetDensity()/(g/cm3)
+        << " " << material->GetState() << " " << material->GetTemperature()/kelvin
+        << " " << material->GetPressure()/atmosphere << std::endl;
+    const G4double* fractions = material->GetFractionVector();
+    for (size_t i = 0; i < material->GetNumberOfElements(); i++) {
+      const G4Element* element = material->GetElement(i);
+      key << "  element " << element->GetName() << " " << fractions[i];
+      const G4double* abundances = element->GetRelativeAbundanceVector();
+      for (size_t j = 0; j < element->GetNumberOfIsotopes(); j++) {
+        key << " " << element->GetIsotope(j)->GetN() << ":" << abundances[j];
+      }
+      key << std::endl;
+    }
+  }
+  return key.str();
+}
+
+//
+//
+
+void PhysicsTableCache::Lookup()
+{
+  fKey = MakeKey();
+  fKeyDirectory = fDirectory + "/" + Hash(fKey);
+
+  // A directory only exists once it is complete; the key inside guards
+  // against hash collisions.
+  std::ifstream keyFile(fKeyDirectory + "/cache.key");
+  std::ostringstream stored;
+  if (keyFile) stored << keyFile.rdbuf();
+  fRetrieved = (keyFile && stored.str() == fKey);
+  if (fRetrieved) {
+    G4cout << "PhysicsTableCache: reading physics tables from " << fKeyDirectory << G4endl;
+    fPhysicsList->SetPhysicsTableRetrieved(fKeyDirectory);
+  } else {
+    G4cout << "PhysicsTableCache: no tables for this setup in " << fDirectory
+           << ", building them." << G4endl;
+    fPhysicsList->ResetPhysicsTableRetrieved();
+  }
+}
+
+//
+//
+
+void PhysicsTableCache::Store()
+{
+  mkdir(fDirectory.c_str(), 0755);
+  // Unique per process, also across the nodes sharing the directory.
+  char host[256] = "";
+  gethostname(host, sizeof(host) - 1);
+  G4String tmpDirectory = fKeyDirectory + ".tmp-" + host + "-" + std::to_string(getpid());
+  mkdir(tmpDirectory.c_str(), 0755);
+  if (!fPhysicsList->StorePhysicsTable(tmpDirectory)) {
+    G4cout << "PhysicsTableCache: storing the tables in " << tmpDirectory << " failed." << G4endl;
+    RemoveDirectory(tmpDirectory);
+    return;
+  }
+  std::ofstream keyFile(tmpDirectory + "/cache.key");
+  keyFile << fKey;
+  keyFile.close();
+  // Fails if a concurrent job got there first; its tables are as good.
+  if (std::rename(tmpDirectory.c_str(), fKeyDirectory.c_str()) != 0) {
+    RemoveDirectory(tmpDirectory);
+    G4cout << "PhysicsTableCache: tables for this setup already in " << fKeyDirectory << G4endl;
+    return;
+  }
+  G4cout << "PhysicsTableCache: physics tables stored in " << fKeyDirectory << G4endl;
+}
@@ -5,19 +5,35 @@
 /// \file Source code for PrimaryGeneratorAction class.
 
 #include "PrimaryGeneratorAction.hh"
+#include "PrimaryGeneratorMessenger.hh"
 
 #include "G4LogicalVolumeStore.hh"
 #include "G4LogicalVolume.hh"
 #include "G4Box.hh"
 #include "G4RunManager.hh"
 #include "G4GeneralParticleSource.hh"
+#include "G4SPSEneDistribution.hh"
+#include "G4PhysicsFreeVector.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4Event.hh"
 #include "G4ParticleTable.hh"
 #include "G4SystemOfUnits.hh"
 #include "Randomize.hh"
+#include "DetectorConstruction.hh"
 
-PrimaryGeneratorAction::PrimaryGeneratorAction() : G4VUserPrimaryGeneratorAction(), fParticleGun(0)
+#include <algorithm>
+#include <cmath>
+
+G4double PrimaryGeneratorAction::fFixedEnergy = 0.;
+G4ThreeVector PrimaryGeneratorAction::fFixedDirection;
+std::atomic<G4bool> PrimaryGeneratorAction::fSurfaceSource(false);
+
+PrimaryGeneratorAction::PrimaryGeneratorAction() : G4VUserPrimaryGeneratorAction(), fParticleGun(0),
+  fSourceMode("gps"), fBiasMode("off"), fBiasMixing(0.5), fBiasBuilt(false)
 {
   fParticleGun = new G4GeneralParticleSource();
+  fMessenger = new PrimaryGeneratorMessenger(this);
 }
 
 //
@@ -25,13 +41,226 @@ PrimaryGeneratorAction::PrimaryGeneratorAction() : G4VUserPrimaryGeneratorAction
 
 PrimaryGeneratorAction::~PrimaryGeneratorAction()
 {
+  delete fMessenger;
   delete fParticleGun;
 }
 
 //
 //
 
+void PrimaryGeneratorAction::SetEnergyBiasing(const G4String& mode)
+{
+  fBiasMode = mode;
+  fBiasBuilt = false;
+}
+
+//
+//
+
+void PrimaryGeneratorAction::SetBiasMixing(G4double fraction)
+{
+  fBiasMixing = fraction;
+  fBiasBuilt = false;
+}
+
+//
+//
+
+void PrimaryGeneratorAction::AddBiasPoint(G4double energy, G4double weight)
+{
+  fBiasPoints.push_back(energy);
+  fBiasWeights.push_back(weight);
+  fBiasBuilt = false;
+}
+
+//
+//
+
+void PrimaryGeneratorAction::ClearBiasPoints()
+{
+  fBiasPoints.clear();
+  fBiasWeights.clear();
+  fBiasBuilt = false;
+}
+
+//
+//
+
+void PrimaryGeneratorAction::BuildHistogram(const std::vector<G4double>& points, const std::vector<G4double>& weights, Histogram& hist)
+{
+  // Same convention as /gps/hist/point: the first point is the lower edge,
+  // every other point closes a group holding its weight, flat in energy.
+  hist.edges = points;
+  hist.density.assign(points.size(), 0.);
+  hist.cumulative.assign(points.size(), 0.);
+  for (size_t i = 1; i < points.size(); i++) {
+    G4double width = points[i] - points[i - 1];
+    G4double w = (width > 0.) ? weights[i] : 0.;
+    hist.cumulative[i] = hist.cumulative[i - 1] + w;
+    if (width > 0.) hist.density[i] = w/width;
+  }
+  G4double norm = hist.cumulative.empty() ? 0. : hist.cumulative.back();
+  if (norm <= 0.) return;
+  for (size_t i = 0; i < points.size(); i++) {
+    hist.density[i] /= norm;
+    hist.cumulative[i] /= norm;
+  }
+}
+
+//
+//
+
+G4double PrimaryGeneratorAction::Density(const Histogram& hist, G4double energy)
+{
+  auto itr = std::upper_bound(hist.edges.begin(), hist.edges.end(), energy);
+  if (itr == hist.edges.begin() || itr == hist.edges.end()) return 0.;
+  return hist.density[itr - hist.edges.begin()];
+}
+
+//
+//
+
+void PrimaryGeneratorAction::BuildBiasing()
+{
+  G4PhysicsFreeVector userHisto = fParticleGun->GetCurrentSource()->GetEneDist()->GetUserDefinedEnergyHisto();
+  std::vector<G4double> points, weights;
+  for (size_t i = 0; i < userHisto.GetVectorLength(); i++) {
+    points.push_back(userHisto.Energy(i)*MeV);
+    weights.push_back(userHisto(i));
+  }
+  if (points.size() < 2) {
+    G4Exception("PrimaryGeneratorAction::BuildBiasing()", "BF3Gun001", FatalException,
+                "Energy biasing needs a /gps/hist/point energy spectrum.");
+  }
+  BuildHistogram(points, weights, fSource);
+
+  if (fBiasMode == "auto") {
+    // Defensive mixture: every group keeps at least fBiasMixing/n of the
+    // histories and the weights stay below 1/(1 - fBiasMixing).
+    G4int nGroups = 0;
+    for (size_t i = 1; i < points.size(); i++) {
+      if (points[i] > points[i - 1]) nGroups++;
+    }
+    std::vector<G4double> biased(points.size(), 0.);
+    for (size_t i = 1; i < points.size(); i++) {
+      if (points[i] <= points[i - 1]) continue;
+      G4double p = fSource.cumulative[i] - fSource.cumulative[i - 1];
+      biased[i] = (1. - fBiasMixing)*p + fBiasMixing/nGroups;
+    }
+    BuildHistogram(points, biased, fBiased);
+  } else {
+    if (fBiasPoints.size() < 2) {
+      G4Exception("PrimaryGeneratorAction::BuildBiasing()", "BF3Gun002", FatalException,
+                  "User energy biasing needs at least two /BF3/gun/biasPoint entries.");
+    }
+    BuildHistogram(fBiasPoints, fBiasWeights, fBiased);
+    // The biased distribution must cover the whole source spectrum.
+    for (size_t i = 1; i < points.size(); i++) {
+      if (fSource.density[i] > 0. && Density(fBiased, 0.5*(points[i - 1] + points[i])) <= 0.) {
+        G4Exception("PrimaryGeneratorAction::BuildBiasing()", "BF3Gun003", JustWarning,
+                    "Biased energy histogram is zero where the source spectrum is not; results are biased.");
+        break;
+      }
+    }
+  }
+  fBiasBuilt = true;
+}
+
+//
+//
+
+G4double PrimaryGeneratorAction::ProjectedArea(const G4ThreeVector& direction)
+{
+  const DetectorConstruction* detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  G4ThreeVector size = detector->GetModeratorSize();
+  G4ThreeVector d = direction.unit();
+  return size.y()*size.z()*std::abs(d.x()) + size.x()*size.z()*std::abs(d.y())
+       + size.x()*size.y()*std::abs(d.z());
+}
+
+//
+//
+
+void PrimaryGeneratorAction::GenerateSurfacePoint(G4ThreeVector& position, G4ThreeVector& direction) const
+{
+  const DetectorConstruction* detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  G4ThreeVector half = 0.5*detector->GetModeratorSize();
+  G4double a = half.x(), b = half.y(), c = half.z();
+  G4bool beam = fFixedDirection.mag2() > 0.;
+  G4ThreeVector d = fFixedDirection.unit();
+  // Pick a face with probability proportional to its area, or for a
+  // parallel beam to its area projected on the beam.
+  G4double areaX = b*c, areaY = a*c, areaZ = a*b;
+  if (beam) {
+    areaX *= std::abs(d.x());
+    areaY *= std::abs(d.y());
+    areaZ *= std::abs(d.z());
+  }
+  G4double r = G4UniformRand()*(areaX + areaY + areaZ);
+  G4int axis = (r < areaX) ? 0 : ((r < areaX + areaY) ? 1 : 2);
+  G4double sign = (G4UniformRand() < 0.5) ? -1. : 1.;
+  // The beam only enters through the faces turned towards it.
+  if (beam) sign = (d[axis] > 0.) ? -1. : 1.;
+  G4ThreeVector u(2.*G4UniformRand() - 1., 2.*G4UniformRand() - 1., 2.*G4UniformRand() - 1.);
+  // Start just outside the face so the primary begins in the air.
+  G4double offset = 1.*um;
+  G4ThreeVector normal;
+  if (axis == 0) {
+    position.set(sign*(a + offset), u.y()*b, u.z()*c);
+    normal.set(-sign, 0., 0.);
+  } else if (axis == 1) {
+    position.set(u.x()*a, sign*(b + offset), u.z()*c);
+    normal.set(0., -sign, 0.);
+  } else {
+    position.set(u.x()*a, u.y()*b, sign*(c + offset));
+    normal.set(0., 0., -sign);
+  }
+  if (beam) {
+    direction = d;
+    return;
+  }
+  // Cosine law about the inward normal.
+  G4double cosTheta = std::sqrt(G4UniformRand());
+  G4double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+  G4double phi = CLHEP::twopi*G4UniformRand();
+  direction.set(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+  direction.rotateUz(normal);
+}
+
+//
+//
+
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 {
   fParticleGun->GeneratePrimaryVertex(anEvent);
-}
\ No newline at end of file
+  if (fFixedEnergy > 0.) {
+    G4PrimaryParticle* primary = anEvent->GetPrimaryVertex()->GetPrimary();
+    primary->SetKineticEnergy(fFixedEnergy);
+    if (fFixedDirection.mag2() > 0.) primary->SetMomentumDirection(fFixedDirection);
+  }
+  if (fSourceMode == "surface") {
+    G4ThreeVector position, direction;
+    GenerateSurfacePoint(position, direction);
+    G4PrimaryVertex* vertex = anEvent->GetPrimaryVertex();
+    vertex->SetPosition(position.x(), position.y(), position.z());
+    vertex->GetPrimary()->SetMomentumDirection(direction);
+  }
+  // A fixed energy is not sampled, so there is nothing to bias.
+  if (fBiasMode == "off" || fFixedEnergy > 0.) return;
+  if (!fBiasBuilt) BuildBiasing();
+
+  // Sample the biased histogram and carry p/q on the primary.
+  G4double r = G4UniformRand();
+  auto itr = std::upper_bound(fBiased.cumulative.begin(), fBiased.cumulative.end(), r);
+  if (itr == fBiased.cumulative.begin() || itr == fBiased.cumulative.end()) return;
+  size_t i = itr - fBiased.cumulative.begin();
+  G4double frac = (r - fBiased.cumulative[i - 1])/(fBiased.cumulative[i] - fBiased.cumulative[i - 1]);
+  G4double energy = fBiased.edges[i - 1] + frac*(fBiased.edges[i] - fBiased.edges[i - 1]);
+  G4double weight = Density(fSource, energy)/fBiased.density[i];
+
+  G4PrimaryParticle* primary = anEvent->GetPrimaryVertex()->GetPrimary();
+  primary->SetKineticEnergy(energy);
+  primary->SetWeight(primary->GetWeight()*weight);
+}
@@ -0,0 +1,97 @@
+// Source code for PrimaryGeneratorMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file PrimaryGeneratorMessenger.cc
+/// \file Source code for PrimaryGeneratorMessenger class.
+
+#include "PrimaryGeneratorAction.hh"
+#include "PrimaryGeneratorMessenger.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <sstream>
+
+PrimaryGeneratorMessenger::PrimaryGeneratorMessenger(PrimaryGeneratorAction* myPrimaryGenerator)
+: G4UImessenger(), fPrimaryGenerator(myPrimaryGenerator)
+{
+  fGunDir = new G4UIdirectory("/BF3/gun/");
+  fGunDir->SetGuidance("Control parameters set within PrimaryGeneratorAction.");
+
+  fSourceMode = new G4UIcmdWithAString("/BF3/gun/source", this);
+  fSourceMode->SetGuidance("Source sampling:");
+  fSourceMode->SetGuidance("  gps     - position and direction as set with /gps/,");
+  fSourceMode->SetGuidance("  surface - uniform on the moderator surface, inward cosine law,");
+  fSourceMode->SetGuidance("            a parallel beam on the faces it sees for a /BF3/sweep/ direction.");
+  fSourceMode->SetGuidance("Energy and particle always come from /gps/.");
+  fSourceMode->SetParameterName("mode", false);
+  fSourceMode->SetCandidates("gps surface");
+  fSourceMode->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBiasMode = new G4UIcmdWithAString("/BF3/gun/biasEnergy", this);
+  fBiasMode->SetGuidance("Energy biasing of the primary spectrum:");
+  fBiasMode->SetGuidance("  off  - sample the GPS spectrum as is,");
+  fBiasMode->SetGuidance("  auto - mix the GPS spectrum with a flat distribution over its groups,");
+  fBiasMode->SetGuidance("  user - sample the /BF3/gun/biasPoint histogram.");
+  fBiasMode->SetParameterName("mode", false);
+  fBiasMode->SetCandidates("off auto user");
+  fBiasMode->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBiasMixing = new G4UIcmdWithADouble("/BF3/gun/biasMixing", this);
+  fBiasMixing->SetGuidance("Fraction of the flat distribution in auto mode.");
+  fBiasMixing->SetParameterName("fraction", false);
+  fBiasMixing->SetRange("fraction>=0. && fraction<1.");
+  fBiasMixing->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBiasPoint = new G4UIcommand("/BF3/gun/biasPoint", this);
+  fBiasPoint->SetGuidance("Add a point of the biased histogram, as for /gps/hist/point.");
+  fBiasPoint->SetGuidance("Energies are in MeV.");
+  G4UIparameter* energy = new G4UIparameter("energy", 'd', false);
+  fBiasPoint->SetParameter(energy);
+  G4UIparameter* weight = new G4UIparameter("weight", 'd', false);
+  fBiasPoint->SetParameter(weight);
+  fBiasPoint->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fClearBias = new G4UIcmdWithoutParameter("/BF3/gun/clearBiasPoints", this);
+  fClearBias->SetGuidance("Remove all points of the biased histogram.");
+  fClearBias->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//
+//
+
+PrimaryGeneratorMessenger::~PrimaryGeneratorMessenger()
+{
+  delete fSourceMode;
+  delete fBiasMode;
+  delete fBiasMixing;
+  delete fBiasPoint;
+  delete fClearBias;
+  delete fGunDir;
+}
+
+//
+//
+
+void PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command, G4String newVal)
+{
+  if (command == fSourceMode) {
+    fPrimaryGenerator->SetSourceMode(newVal);
+  } else if (command == fBiasMode) {
+    fPrimaryGenerator->SetEnergyBiasing(newVal);
+  } else if (command == fBiasMixing) {
+    fPrimaryGenerator->SetBiasMixing(fBiasMixing->GetNewDoubleValue(newVal));
+  } else if (command == fBiasPoint) {
+    G4double energy, weight;
+    std::istringstream is(newVal);
+    is >> energy >> weight;
+    fPrimaryGenerator->AddBiasPoint(energy*MeV, weight);
+  } else if (command == fClearBias) {
+    fPrimaryGenerator->ClearBiasPoints();
+  }
+}
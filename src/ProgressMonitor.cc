@@ -0,0 +1,131 @@
+// Source code for ProgressMonitor().
+// Created by agent on October 17, 2026.
+
+/// \file ProgressMonitor.cc
+/// \brief Source code for ProgressMonitor class.
+
+#include "ProgressMonitor.hh"
+#include "ProgressMonitorMessenger.hh"
+
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+  ProgressMonitor* theMonitor = 0;
+}
+
+ProgressMonitor::ProgressMonitor()
+: fInterval(60.*s), fToProcess(0.), fNSlots(0), fDone(true)
+{
+  fMessenger = new ProgressMonitorMessenger(this);
+}
+
+//
+//
+
+ProgressMonitor::~ProgressMonitor()
+{
+  EndRun();
+  delete fMessenger;
+}
+
+//
+//
+
+ProgressMonitor* ProgressMonitor::GetInstance()
+{
+  // Created on the master in main(); the workers only count.
+  if (!theMonitor) {
+    theMonitor = new ProgressMonitor();
+  }
+  return theMonitor;
+}
+
+//
+//
+
+void ProgressMonitor::BeginRun(const G4Run* aRun)
+{
+  EndRun();
+  fToProcess = aRun->GetNumberOfEventToBeProcessed();
+  // The counters are set up before any worker starts its event loop.
+  fNSlots = G4RunManager::GetRunManager()->GetNumberOfThreads() + 1;
+  fSlots.reset(new Slot[fNSlots]);
+  if (fInterval <= 0.) return;
+  fDone = false;
+  fTimer = std::thread(&ProgressMonitor::Loop, this);
+}
+
+//
+//
+
+void ProgressMonitor::EndRun()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fDone = true;
+  }
+  fWakeUp.notify_all();
+  if (fTimer.joinable()) fTimer.join();
+}
+
+//
+//
+
+void ProgressMonitor::Loop()
+{
+  typedef std::chrono::steady_clock Clock;
+  const Clock::time_point start = Clock::now();
+  Clock::time_point last = start;
+  std::vector<std::int64_t> lastEvents(fNSlots, 0);
+  const std::chrono::duration<G4double> interval(fInterval/s);
+  std::unique_lock<std::mutex> lock(fMutex);
+  while (!fWakeUp.wait_for(lock, interval, [this] { return fDone; })) {
+    Clock::time_point now = Clock::now();
+    Report(std::chrono::duration<G4double>(now - start).count(),
+           std::chrono::duration<G4double>(now - last).count(), lastEvents.data());
+    last = now;
+  }
+}
+
+//
+//
+
+void ProgressMonitor::Report(G4double elapsed, G4double sinceLast, std::int64_t* lastEvents) const
+{
+  G4double events = 0.;
+  G4double counts = 0.;
+  G4double recent = 0.;
+  std::ostringstream threads;
+  for (size_t i = 0; i < fNSlots; i++) {
+    std::int64_t n = fSlots[i].events.load(std::memory_order_relaxed);
+    events += n;
+    counts += fSlots[i].counts.load(std::memory_order_relaxed);
+    recent += n - lastEvents[i];
+    // The master slot only counts in sequential runs.
+    if (i > 0 || fNSlots == 2) threads << " " << G4int((n - lastEvents[i])/sinceLast);
+    lastEvents[i] = n;
+  }
+  G4double rate = (elapsed > 0.) ? events/elapsed : 0.;
+  G4double recentRate = (sinceLast > 0.) ? recent/sinceLast : 0.;
+
+  // Built first and written in one go, from this thread only.
+  std::ostringstream out;
+  out << "Progress: " << events << " of " << fToProcess << " events ("
+      << ((fToProcess > 0.) ? 100.*events/fToProcess : 0.) << " %), "
+      << elapsed << " s elapsed, " << rate << " events/s (last " << recentRate << "), "
+      << ((elapsed > 0.) ? counts/elapsed : 0.) << " counts/s, ETA ";
+  if (recentRate > 0.) {
+    out << (fToProcess - events)/recentRate << " s";
+  } else {
+    out << "unknown";
+  }
+  out << std::endl << "  events/s per thread:" << threads.str() << std::endl;
+  std::cout << out.str() << std::flush;
+}
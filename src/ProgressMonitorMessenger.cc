@@ -0,0 +1,42 @@
+// Source code for ProgressMonitorMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file ProgressMonitorMessenger.cc
+/// \file Source code for ProgressMonitorMessenger class.
+
+#include "ProgressMonitor.hh"
+#include "ProgressMonitorMessenger.hh"
+
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+ProgressMonitorMessenger::ProgressMonitorMessenger(ProgressMonitor* myMonitor)
+: G4UImessenger(), fMonitor(myMonitor)
+{
+  // The /BF3/run/ directory comes with RunCheckpointMessenger.
+  fInterval = new G4UIcmdWithADoubleAndUnit("/BF3/run/progressInterval", this);
+  fInterval->SetGuidance("Time between progress reports during a run, 0 for none.");
+  fInterval->SetParameterName("time", false);
+  fInterval->SetUnitCategory("Time");
+  fInterval->SetRange("time>=0.");
+  fInterval->AvailableForStates(G4State_PreInit, G4State_Idle);
+  // The reports come from the master.
+  fInterval->SetToBeBroadcasted(false);
+}
+
+//
+//
+
+ProgressMonitorMessenger::~ProgressMonitorMessenger()
+{
+  delete fInterval;
+}
+
+//
+//
+
+void ProgressMonitorMessenger::SetNewValue(G4UIcommand* command, G4String newVal)
+{
+  if (command == fInterval) {
+    fMonitor->SetInterval(fInterval->GetNewDoubleValue(newVal));
+  }
+}
@@ -0,0 +1,69 @@
+// Source code for RandomStreams().
+// Created by agent on October 17, 2026.
+
+/// \file RandomStreams.cc
+/// \brief Source code for RandomStreams class.
+
+#include "RandomStreams.hh"
+
+#include "Randomize.hh"
+#include "CLHEP/Random/MixMaxRng.h"
+
+#include <sstream>
+
+namespace {
+  RandomStreams* theStreams = 0;
+}
+
+RandomStreams::RandomStreams()
+: fBaseSeed(0), fJob(0), fRank(0), fRun(0), fGeneration(0)
+{}
+
+//
+//
+
+RandomStreams::~RandomStreams()
+{}
+
+//
+//
+
+RandomStreams* RandomStreams::GetInstance()
+{
+  // Only the master seeds.
+  if (!theStreams) {
+    theStreams = new RandomStreams();
+  }
+  return theStreams;
+}
+
+//
+//
+
+void RandomStreams::SeedRun(G4int runID, G4int generation)
+{
+  fRun = runID;
+  fGeneration = generation;
+  CLHEP::MixMaxRng* engine = dynamic_cast<CLHEP::MixMaxRng*>(G4Random::getTheEngine());
+  if (!engine) {
+    G4Exception("RandomStreams::SeedRun()", "BF3Rng001", FatalException,
+                "The random engine is not MixMaxRng.");
+    return;
+  }
+  // Four 32 bit IDs; rank and generation share the last one.
+  engine->seed_uniquestream(static_cast<CLHEP::myID_t>(fBaseSeed),
+                            static_cast<CLHEP::myID_t>(fJob),
+                            static_cast<CLHEP::myID_t>(fRun),
+                            static_cast<CLHEP::myID_t>((fGeneration << 16) | fRank));
+}
+
+//
+//
+
+G4String RandomStreams::GetStreamID() const
+{
+  std::ostringstream id;
+  id << "MixMax seed " << fBaseSeed << " job " << fJob << " rank " << fRank
+     << " run " << fRun << " generation " << fGeneration;
+  return id.str();
+}
@@ -0,0 +1,193 @@
+// Source code for ResponseSweep().
+// Created by agent on October 17, 2026.
+
+/// \file ResponseSweep.cc
+/// \brief Source code for ResponseSweep class.
+
+#include "ResponseSweep.hh"
+#include "ResponseSweepMessenger.hh"
+#include "Analysis.hh"
+#include "Run.hh"
+#include "PrimaryGeneratorAction.hh"
+
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+#include <iomanip>
+
+namespace {
+  ResponseSweep* theSweep = 0;
+}
+
+ResponseSweep::ResponseSweep()
+: fEventsPerCell(100000), fFileName("BF3ResponseMatrix.txt"), fRunning(false), fKeepAngular(false)
+{
+  fMessenger = new ResponseSweepMessenger(this);
+}
+
+//
+//
+
+ResponseSweep::~ResponseSweep()
+{
+  delete fMessenger;
+}
+
+//
+//
+
+ResponseSweep* ResponseSweep::GetInstance()
+{
+  // Only the master thread drives the sweep.
+  if (!theSweep) {
+    theSweep = new ResponseSweep();
+  }
+  return theSweep;
+}
+
+//
+//
+
+void ResponseSweep::AddEnergy(G4double energy)
+{
+  Cell cell = {energy, energy, energy, 0., 0.};
+  fEnergies.push_back(cell);
+}
+
+//
+//
+
+void ResponseSweep::UseGroupEnergies()
+{
+  fEnergies.clear();
+  const std::vector<G4double>& edges = Analysis::GetPrimaryEnergyEdges();
+  for (size_t i = 0; i + 1 < edges.size(); i++) {
+    Cell cell;
+    cell.eLow = edges[i]*MeV;
+    cell.eHigh = edges[i + 1]*MeV;
+    cell.energy = std::sqrt(cell.eLow*cell.eHigh);
+    cell.theta = 0.;
+    cell.phi = 0.;
+    fEnergies.push_back(cell);
+  }
+}
+
+//
+//
+
+void ResponseSweep::ClearEnergies()
+{
+  fEnergies.clear();
+}
+
+//
+//
+
+void ResponseSweep::AddDirection(G4double theta, G4double phi)
+{
+  fDirections.push_back(std::make_pair(theta, phi));
+}
+
+//
+//
+
+void ResponseSweep::ClearDirections()
+{
+  fDirections.clear();
+}
+
+//
+//
+
+void ResponseSweep::Start()
+{
+  if (fEnergies.empty()) {
+    G4cout << "ResponseSweep: no energies given, nothing to do." << G4endl;
+    return;
+  }
+  if (!Run::HasPulseHeightTallies()) {
+    G4cout << "ResponseSweep: the pulse height spectra are off with importance"
+           << " splitting, nothing to do." << G4endl;
+    return;
+  }
+  // Without a direction the macro's angular distribution is kept.
+  std::vector<std::pair<G4double, G4double> > directions = fDirections;
+  fKeepAngular = directions.empty();
+  if (fKeepAngular) directions.push_back(std::make_pair(0., 0.));
+
+  fOutput.open(fFileName);
+  fOutput << "# BF3 response matrix" << std::endl;
+  fOutput << "# energies directions bins phsMin[MeV] phsMax[MeV]" << std::endl;
+  fOutput << fEnergies.size() << " " << directions.size() << " 512 0 5" << std::endl;
+  fOutput << "# cell energy[MeV] eLow[MeV] eHigh[MeV] theta[deg] phi[deg] events efficiency efficiencyError" << std::endl;
+  fOutput << "# phs: detections per source neutron in each pulse height bin, phsErr: its error" << std::endl;
+  fOutput << "# source: geometry the efficiencies of the next cell refer to" << std::endl;
+  fOutput << std::setprecision(8);
+
+  G4RunManager* runManager = G4RunManager::GetRunManager();
+  fRunning = true;
+  for (auto ene = fEnergies.begin(); ene != fEnergies.end(); ene++) {
+    for (auto dir = directions.begin(); dir != directions.end(); dir++) {
+      fCurrent = *ene;
+      fCurrent.theta = dir->first;
+      fCurrent.phi = dir->second;
+      // Direction of flight is opposite to the direction it comes from.
+      G4ThreeVector direction;
+      if (!fKeepAngular) {
+        direction.set(-std::sin(dir->first)*std::cos(dir->second),
+                      -std::sin(dir->first)*std::sin(dir->second), -std::cos(dir->first));
+      }
+      PrimaryGeneratorAction::SetFixedPrimary(ene->energy, direction);
+      runManager->BeamOn(fEventsPerCell);
+    }
+  }
+  // Later runs use the macro's source again.
+  PrimaryGeneratorAction::SetFixedPrimary(0., G4ThreeVector());
+  fRunning = false;
+  fOutput.close();
+  G4cout << "ResponseSweep: response matrix written to " << fFileName << G4endl;
+}
+
+//
+//
+
+void ResponseSweep::RecordRun(const Run* aRun)
+{
+  if (!fRunning) return;
+  // Weighted detections per history, so biased sources stay unbiased.
+  const ConvergenceStats& detected = aRun->GetDetected();
+  G4double events = detected.GetHistories();
+  G4double eff = detected.GetMean();
+  G4double effErr = eff*detected.GetRelativeError();
+  // Workers only take /BF3/gun/source at the start of a run, so the source
+  // geometry is known here and not yet in Start().
+  if (PrimaryGeneratorAction::UsesSurfaceSource()) {
+    G4ThreeVector direction(-std::sin(fCurrent.theta)*std::cos(fCurrent.phi),
+                            -std::sin(fCurrent.theta)*std::sin(fCurrent.phi), -std::cos(fCurrent.theta));
+    // The cosine-law current through the whole surface is F*A/4, A/4 being
+    // half the sum of the areas projected along the three axes.
+    G4double area = fKeepAngular ? 0.5*(PrimaryGeneratorAction::ProjectedArea(G4ThreeVector(1., 0., 0.))
+                                        + PrimaryGeneratorAction::ProjectedArea(G4ThreeVector(0., 1., 0.))
+                                        + PrimaryGeneratorAction::ProjectedArea(G4ThreeVector(0., 0., 1.)))
+                                 : PrimaryGeneratorAction::ProjectedArea(direction);
+    fOutput << "# source: " << (fKeepAngular ? "moderator surface, inward cosine law"
+                                              : "moderator surface, parallel beam")
+            << ", per unit fluence multiply by A[cm2] " << area/cm2 << std::endl;
+  } else {
+    fOutput << "# source: GPS position distribution of the macro" << std::endl;
+  }
+  fOutput << "cell " << fCurrent.energy/MeV << " " << fCurrent.eLow/MeV << " "
+          << fCurrent.eHigh/MeV << " " << fCurrent.theta/deg << " " << fCurrent.phi/deg
+          << " " << events << " " << eff << " " << effErr << std::endl;
+  const Tally1D& phs = aRun->GetEDepTot();
+  fOutput << "phs";
+  for (G4int i = 1; i <= phs.GetNbins(); i++) {
+    fOutput << " " << ((events > 0.) ? phs.GetSw(i)/events : 0.);
+  }
+  fOutput << std::endl << "phsErr";
+  for (G4int i = 1; i <= phs.GetNbins(); i++) {
+    fOutput << " " << ((events > 0.) ? std::sqrt(phs.GetSw2(i))/events : 0.);
+  }
+  fOutput << std::endl;
+}
@@ -0,0 +1,129 @@
+// Source code for ResponseSweepMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file ResponseSweepMessenger.cc
+/// \file Source code for ResponseSweepMessenger class.
+
+#include "ResponseSweep.hh"
+#include "ResponseSweepMessenger.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UnitsTable.hh"
+
+#include <sstream>
+
+ResponseSweepMessenger::ResponseSweepMessenger(ResponseSweep* mySweep)
+: G4UImessenger(), fSweep(mySweep)
+{
+  fSweepDir = new G4UIdirectory("/BF3/sweep/");
+  fSweepDir->SetGuidance("Response matrix sweep over energies and incident directions.");
+
+  fAddEnergy = new G4UIcmdWithADoubleAndUnit("/BF3/sweep/addEnergy", this);
+  fAddEnergy->SetGuidance("Add a monoenergetic source energy to the sweep.");
+  fAddEnergy->SetParameterName("energy", false);
+  fAddEnergy->SetUnitCategory("Energy");
+  fAddEnergy->SetRange("energy>0.");
+  fAddEnergy->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fGroupEnergies = new G4UIcmdWithoutParameter("/BF3/sweep/useGroupEnergies", this);
+  fGroupEnergies->SetGuidance("Sweep the PrimEnergy groups, one cell per group at the");
+  fGroupEnergies->SetGuidance("logarithmic mid-point of the group.");
+  fGroupEnergies->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fClearEnergies = new G4UIcmdWithoutParameter("/BF3/sweep/clearEnergies", this);
+  fClearEnergies->SetGuidance("Remove all sweep energies.");
+  fClearEnergies->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fAddDirection = new G4UIcommand("/BF3/sweep/addDirection", this);
+  fAddDirection->SetGuidance("Add an incident direction, given by the polar and azimuthal");
+  fAddDirection->SetGuidance("angles the neutrons come from.");
+  G4UIparameter* theta = new G4UIparameter("theta", 'd', false);
+  fAddDirection->SetParameter(theta);
+  G4UIparameter* phi = new G4UIparameter("phi", 'd', true);
+  phi->SetDefaultValue(0.);
+  fAddDirection->SetParameter(phi);
+  G4UIparameter* unit = new G4UIparameter("unit", 's', true);
+  unit->SetDefaultValue("deg");
+  fAddDirection->SetParameter(unit);
+  fAddDirection->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fClearDirections = new G4UIcmdWithoutParameter("/BF3/sweep/clearDirections", this);
+  fClearDirections->SetGuidance("Remove all sweep directions.");
+  fClearDirections->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fEvents = new G4UIcmdWithAnInteger("/BF3/sweep/eventsPerCell", this);
+  fEvents->SetGuidance("Number of events per (energy, direction) cell.");
+  fEvents->SetParameterName("events", false);
+  fEvents->SetRange("events>0");
+  fEvents->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fFileName = new G4UIcmdWithAString("/BF3/sweep/fileName", this);
+  fFileName->SetGuidance("Set the file name for the response matrix.");
+  fFileName->SetParameterName("choice", false);
+  fFileName->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fRun = new G4UIcmdWithoutParameter("/BF3/sweep/run", this);
+  fRun->SetGuidance("Run the sweep and write the response matrix.");
+  fRun->AvailableForStates(G4State_Idle);
+
+  // The sweep only exists on the master.
+  fAddEnergy->SetToBeBroadcasted(false);
+  fGroupEnergies->SetToBeBroadcasted(false);
+  fClearEnergies->SetToBeBroadcasted(false);
+  fAddDirection->SetToBeBroadcasted(false);
+  fClearDirections->SetToBeBroadcasted(false);
+  fEvents->SetToBeBroadcasted(false);
+  fFileName->SetToBeBroadcasted(false);
+  fRun->SetToBeBroadcasted(false);
+}
+
+//
+//
+
+ResponseSweepMessenger::~ResponseSweepMessenger()
+{
+  delete fAddEnergy;
+  delete fGroupEnergies;
+  delete fClearEnergies;
+  delete fAddDirection;
+  delete fClearDirections;
+  delete fEvents;
+  delete fFileName;
+  delete fRun;
+  delete fSweepDir;
+}
+
+//
+//
+
+void ResponseSweepMessenger::SetNewValue(G4UIcommand* command, G4String newVal)
+{
+  if (command == fAddEnergy) {
+    fSweep->AddEnergy(fAddEnergy->GetNewDoubleValue(newVal));
+  } else if (command == fGroupEnergies) {
+    fSweep->UseGroupEnergies();
+  } else if (command == fClearEnergies) {
+    fSweep->ClearEnergies();
+  } else if (command == fAddDirection) {
+    G4double theta, phi;
+    G4String unit;
+    std::istringstream is(newVal);
+    is >> theta >> phi >> unit;
+    G4double value = G4UIcommand::ValueOf(unit);
+    fSweep->AddDirection(theta*value, phi*value);
+  } else if (command == fClearDirections) {
+    fSweep->ClearDirections();
+  } else if (command == fEvents) {
+    fSweep->SetEventsPerCell(fEvents->GetNewIntValue(newVal));
+  } else if (command == fFileName) {
+    fSweep->SetFileName(newVal);
+  } else if (command == fRun) {
+    fSweep->Start();
+  }
+}
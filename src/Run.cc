@@ -7,14 +7,14 @@
 #include "Run.hh"
 #include "DetectorConstruction.hh"
 #include "Analysis.hh"
+#include "BF3SensitiveDetector.hh"
+#include "RunCheckpoint.hh"
+#include "ProgressMonitor.hh"
 
 #include "G4RunManager.hh"
 #include "G4Event.hh"
 #include "G4Threading.hh"
-#include "G4SDManager.hh"
-#include "G4MultiFunctionalDetector.hh"
-#include "G4THitsMap.hh"
-#include "G4HCofThisEvent.hh"
+#include "G4Neutron.hh"
 #include "G4PrimaryVertex.hh"
 #include "G4ThreeVector.hh"
 #include "G4WorkerThread.hh"
@@ -24,8 +24,24 @@
 
 #include <atomic>
 
+G4bool Run::fPulseHeightTallies = true;
+
 Run::Run()
+: fEDep1(512, 0., 5.), fEDep2(512, 0., 5.), fEDepTot(512, 0., 5.),
+  fPrimaryEne(Analysis::GetPrimaryEnergyEdges()),
+  fPrimaryPos(180, -9., 9., 110, -5.5, 5.5),
+  fConv1("BF3EnergyDep1"), fConv2("BF3EnergyDep2"), fConvTot("BF3EnergyDepTot"),
+  fDetected("BF3Detected")
 {
+  for (G4int i = 0; i < kNKillReasons; i++) {
+    fKilled[i] = 0.;
+    fKilledEnergy[i] = 0.;
+  }
+  // Checkpoints are off while the interval is zero.
+  G4double interval = RunCheckpoint::GetInstance()->GetInterval()/s;
+  fCheckpointInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+    std::chrono::duration<G4double>(interval));
+  fNextCheckpoint = std::chrono::steady_clock::now() + fCheckpointInterval;
 }
 
 //
@@ -42,61 +58,114 @@ void Run::Merge(const G4Run* aRun)
   G4Run::Merge(aRun);
 
   const Run* localRun = static_cast<const Run*>(aRun);
+  fEDep1.Merge(localRun->fEDep1);
+  fEDep2.Merge(localRun->fEDep2);
+  fEDepTot.Merge(localRun->fEDepTot);
+  fPrimaryEne.Merge(localRun->fPrimaryEne);
+  fPrimaryPos.Merge(localRun->fPrimaryPos);
+  fConv1.Merge(localRun->fConv1);
+  fConv2.Merge(localRun->fConv2);
+  fConvTot.Merge(localRun->fConvTot);
+  fDetected.Merge(localRun->fDetected);
+  for (G4int i = 0; i < kNKillReasons; i++) {
+    fKilled[i] += localRun->fKilled[i];
+    fKilledEnergy[i] += localRun->fKilledEnergy[i];
+  }
 }
 
 //
 //
 
-void Run::RecordEvent(const G4Event* anEvent)
+void Run::GetBlocks(std::vector<std::pair<G4double*, G4int> >& blocks)
+{
+  fEDep1.GetBlocks(blocks);
+  fEDep2.GetBlocks(blocks);
+  fEDepTot.GetBlocks(blocks);
+  fPrimaryEne.GetBlocks(blocks);
+  fPrimaryPos.GetBlocks(blocks);
+  fConv1.GetBlocks(blocks);
+  fConv2.GetBlocks(blocks);
+  fConvTot.GetBlocks(blocks);
+  fDetected.GetBlocks(blocks);
+  blocks.push_back(std::make_pair(fKilled, G4int(kNKillReasons)));
+  blocks.push_back(std::make_pair(fKilledEnergy, G4int(kNKillReasons)));
+}
+
+//
+//
+
+void Run::ShowKills(std::ostream& out) const
 {
-  G4int eventNum = anEvent->GetEventID();
-  if (eventNum % 100000 == 0) {
-    std::cout << "Event number " << eventNum << " started." << std::endl;
+  static const char* names[kNKillReasons] = {
+    "gamma/e-/e+", "charged out of reach of the gas", "neutron time limit",
+    "neutron energy limit", "neutron killed in flight"};
+  out << "Killed tracks (count, kinetic energy [MeV]):" << std::endl;
+  for (G4int i = 0; i < kNKillReasons; i++) {
+    out << "  " << names[i] << ": " << fKilled[i] << ", " << fKilledEnergy[i]/MeV << std::endl;
   }
-  Analysis* myAnalysis = Analysis::GetAnalysis();
-  G4SDManager* sdMan = G4SDManager::GetSDMpointer();
+}
+
+//
+//
+
+void Run::RecordEvent(const G4Event* anEvent)
+{
   // Get Primary Energy information:
   G4PrimaryVertex* pVertex = anEvent->GetPrimaryVertex();
   G4ThreeVector primPos = pVertex->GetPosition();
   G4PrimaryParticle* primary = pVertex->GetPrimary();
-  if (primary->GetG4code()->GetParticleName() == "neutron") {
+  // Statistical weight of the history (energy biasing etc.):
+  G4double primWeight = pVertex->GetWeight()*primary->GetWeight();
+  if (primary->GetG4code() == G4Neutron::Definition()) {
     G4double primEnergy = primary->GetKineticEnergy();
-    myAnalysis->FillPrimaryEne(primEnergy/MeV);
-    myAnalysis->FillPrimaryPos(primPos.getX()/cm, primPos.getY()/cm);
+    fPrimaryEne.Fill(primEnergy/MeV, primWeight);
+    fPrimaryPos.Fill(primPos.getX()/cm, primPos.getY()/cm, primWeight);
   }
   //G4cout << "Primary Energy is: " << energy/MeV << G4endl;
-  G4HCofThisEvent* hce = anEvent->GetHCofThisEvent();
-  G4int collID1 = sdMan->GetCollectionID("BF31/EnergyDep1");
-  if (!hce) return;
-  G4THitsMap<G4double>* eventMap1 = 0;
-  eventMap1 = static_cast<G4THitsMap<G4double>*>(hce->GetHC(collID1));
-  if ((eventMap1 && eventMap1->entries() >= 1)) {
-    G4double val1 = 0.;
-    for (auto itr = eventMap1->begin(); itr != eventMap1->end(); itr++) {
-      val1 += *itr->second;
-    }
-    //G4cout << "Detector 1: " << val1/MeV << G4endl;
-    if ((val1) > 0./MeV) {
-      myAnalysis->FillEDep1((val1)/MeV);
-      myAnalysis->FillEDepTot((val1)/MeV);
-    }
+  // Deposits carry the weight of the track that made them.
+  const BF3SensitiveDetector::EventBuffer& eDeps = BF3SensitiveDetector::GetEventBuffer();
+  G4double val1 = eDeps.eDep[0];
+  G4double val2 = eDeps.eDep[1];
+  G4double weight1 = eDeps.weight[0];
+  G4double weight2 = eDeps.weight[1];
+  //G4cout << "Detector 1: " << val1/MeV << G4endl;
+  if (fPulseHeightTallies && (val1) > 0./MeV) {
+    fEDep1.Fill((val1)/MeV, weight1);
+    fEDepTot.Fill((val1)/MeV, weight1);
   }
-  G4int collID2 = sdMan->GetCollectionID("BF32/EnergyDep2");
-  if (!hce) return;
-  G4THitsMap<G4double>* eventMap2 = 0;
-  eventMap2 = static_cast<G4THitsMap<G4double>*>(hce->GetHC(collID2));
-  if ((eventMap2 && eventMap2->entries() >= 1)) {
-    G4double val2 = 0.;
-    for (auto itr = eventMap2->begin(); itr != eventMap2->end(); itr++) {
-      val2 += *itr->second;
-    }
-    //G4cout << "Detector 2: " << val2/MeV << G4endl;
-    if ((val2) > 0./MeV) {
-      myAnalysis->FillEDep2((val2)/MeV);
-      myAnalysis->FillEDepTot((val2)/MeV);
-    }
+  //G4cout << "Detector 2: " << val2/MeV << G4endl;
+  if (fPulseHeightTallies && (val2) > 0./MeV) {
+    fEDep2.Fill((val2)/MeV, weight2);
+    fEDepTot.Fill((val2)/MeV, weight2);
   }
-  
+  ScoreConvergence(eDeps.weightedEDep[0], eDeps.weightedEDep[1]);
+  // A detection is a property of the whole history, like a pulse height.
+  // Split histories score their captures instead, track by track.
+  fDetected.AddScore(fPulseHeightTallies ? eDeps.detectionWeight : eDeps.captureWeight);
+  ProgressMonitor::GetInstance()->Count(val1 > 0. || val2 > 0.);
 
   G4Run::RecordEvent(anEvent);
+
+  ConvergenceStop* stop = ConvergenceStop::GetInstance();
+  if (stop->IsActive()) stop->Update(this, fStopPublished);
+
+  if (fCheckpointInterval.count() > 0) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now >= fNextCheckpoint) {
+      RunCheckpoint::GetInstance()->Write(this);
+      fNextCheckpoint = now + fCheckpointInterval;
+    }
+  }
+}
+
+//
+//
+
+void Run::ScoreConvergence(G4double val1, G4double val2)
+{
+  // Every history is scored, including the ones with no deposit. The
+  // scores are weighted deposits, so biased runs stay unbiased.
+  fConv1.AddScore(val1/MeV);
+  fConv2.AddScore(val2/MeV);
+  fConvTot.AddScore((val1 + val2)/MeV);
 }
\ No newline at end of file
@@ -7,6 +7,13 @@
 #include "DetectorConstruction.hh"
 #include "Run.hh"
 #include "Analysis.hh"
+#include "ResponseSweep.hh"
+#include "DesignOptimizer.hh"
+#include "RunCheckpoint.hh"
+#include "RandomStreams.hh"
+#include "RunFile.hh"
+#include "ConvergenceStop.hh"
+#include "ProgressMonitor.hh"
 #include <G4WorkerThread.hh>
 #include "G4Run.hh"
 #include "G4Event.hh"
@@ -21,10 +28,31 @@
 #include "G4VPrimitiveScorer.hh"
 #include "G4StatAnalysis.hh"
 #include "G4RunManager.hh"
+#include "G4MTRunManager.hh"
+#ifdef BF3_USE_MPI
+#include "G4MPImanager.hh"
+#include "RunMerger.hh"
+#endif
 
 #include <iostream>
 #include <fstream>
 
+namespace {
+  // With MPI every rank runs its share of the events and only rank 0
+  // writes the merged results.
+  G4bool WritesOutput()
+  {
+#ifdef BF3_USE_MPI
+    return G4MPImanager::GetManager()->IsMaster();
+#else
+    return true;
+#endif
+  }
+}
+
+//
+//
+
 RunAction::RunAction() : G4UserRunAction()
 {
   fMessenger = new RunActionMessenger(this);
@@ -48,11 +76,24 @@ G4Run* RunAction::GenerateRun()
 //
 //
 
-void RunAction::BeginOfRunAction(const G4Run*)
+void RunAction::BeginOfRunAction(const G4Run* aRun)
 {
+  G4String runInfo = "";
+  if (IsMaster()) {
+    fTimer.Start();
+    // Seeded before the run manager draws the event seeds.
+    RunCheckpoint* checkpoint = RunCheckpoint::GetInstance();
+    RandomStreams* streams = RandomStreams::GetInstance();
+    streams->SeedRun(aRun->GetRunID(), checkpoint->GetGeneration());
+    checkpoint->BeginRun(aRun);
+    ConvergenceStop::GetInstance()->BeginRun();
+    ProgressMonitor::GetInstance()->BeginRun(aRun);
+    G4cout << "Random stream: " << streams->GetStreamID() << G4endl;
+    runInfo = "setup: " + RunFile::GetSetup() + " | stream: " + streams->GetStreamID();
+  }
   Analysis* myAnalysis = Analysis::GetAnalysis();
-  myAnalysis->Book(outFileName);
-  myAnalysis->OpenFile(outFileName);
+  myAnalysis->Book(outFileName, runInfo);
+  if (!IsMaster() || WritesOutput()) myAnalysis->OpenFile(outFileName);
 } 
 
 //
@@ -62,10 +103,51 @@ void RunAction::EndOfRunAction(const G4Run* aRun)
 {
   Analysis* myAnalysis = Analysis::GetAnalysis();
   if (IsMaster()) {
+    ProgressMonitor::GetInstance()->EndRun();
+    // A resumed run adds what the checkpoints saved; the Run is only
+    // complete after that, hence the cast.
+    RunCheckpoint* checkpoint = RunCheckpoint::GetInstance();
+    checkpoint->EndRun(const_cast<Run*>(static_cast<const Run*>(aRun)));
+#ifdef BF3_USE_MPI
+    // The threads of this rank are merged; now reduce all ranks to rank 0.
+    RunMerger merger(static_cast<const Run*>(aRun));
+    merger.Merge();
+#endif
+    fTimer.Stop();
+    if (!WritesOutput()) {
+      checkpoint->Clear();
+      return;
+    }
+    G4double runTime = fTimer.GetRealElapsed();
+    // Includes the events restored from checkpoints.
+    G4double nEvents = static_cast<const Run*>(aRun)->GetNumberOfHistories();
     G4cout << "End of Global Run" << G4endl;
+    G4cout << "Events: " << nEvents << ", run time: " << runTime << " s";
+    if (runTime > 0.) G4cout << ", " << nEvents/runTime << " events/s";
+    // Throughput depends on the thread count and the events per request.
+    G4RunManager* runManager = G4RunManager::GetRunManager();
+    G4cout << ", threads: " << runManager->GetNumberOfThreads();
+    const G4MTRunManager* mtRunManager = dynamic_cast<const G4MTRunManager*>(runManager);
+    if (mtRunManager) G4cout << ", grain: " << mtRunManager->GetEventModulo();
+    G4cout << G4endl;
+    G4String stopDecision = ConvergenceStop::GetInstance()->GetDecision();
+    if (!stopDecision.empty()) G4cout << "Convergence stop: " << stopDecision << G4endl;
+    static_cast<const Run*>(aRun)->ShowKills(G4cout);
+    myAnalysis->WriteTallies(static_cast<const Run*>(aRun));
+    ResponseSweep::GetInstance()->RecordRun(static_cast<const Run*>(aRun));
+    DesignOptimizer::GetInstance()->RecordRun(static_cast<const Run*>(aRun));
     myAnalysis->Save();
     myAnalysis->Close();
-    myAnalysis->CheckConvergence();
+    myAnalysis->CheckConvergence(static_cast<const Run*>(aRun), runTime, stopDecision);
+    // The raw sums of the run, for adding up results with bf3-merge.
+    RunFile::Header header;
+    header.setup = RunFile::GetSetup();
+    header.stream = RandomStreams::GetInstance()->GetStreamID();
+    header.runTime = runTime;
+    if (!RunFile::Write(outFileName + "-tally.dat", static_cast<const Run*>(aRun), header)) {
+      G4cout << "Cannot write " << outFileName << "-tally.dat" << G4endl;
+    }
+    checkpoint->Clear();
   } else {
     myAnalysis->Save();
   }
@@ -0,0 +1,297 @@
+// Source code for RunCheckpoint().
+// Created by agent on October 17, 2026.
+
+/// \file RunCheckpoint.cc
+/// \brief Source code for RunCheckpoint class.
+
+#include "RunCheckpoint.hh"
+#include "RunCheckpointMessenger.hh"
+#include "Run.hh"
+#include "RandomStreams.hh"
+#include "RunFile.hh"
+
+#include "G4RunManager.hh"
+#include "G4Threading.hh"
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+#ifdef BF3_USE_MPI
+#include "G4MPImanager.hh"
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <dirent.h>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <utility>
+#include <vector>
+
+namespace {
+  RunCheckpoint* theCheckpoint = 0;
+
+  // Names of the files in dir that start with prefix.
+  std::vector<G4String> ListFiles(const G4String& dir, const G4String& prefix)
+  {
+    std::vector<G4String> names;
+    DIR* d = opendir(dir.c_str());
+    if (!d) return names;
+    while (dirent* entry = readdir(d)) {
+      G4String name = entry->d_name;
+      if (name.compare(0, prefix.size(), prefix) == 0) names.push_back(name);
+    }
+    closedir(d);
+    return names;
+  }
+}
+
+RunCheckpoint::RunCheckpoint()
+: fInterval(600.*s), fGeneration(0), fTotalEvents(0), fResuming(false), fBase(0)
+{
+  fMessenger = new RunCheckpointMessenger(this);
+}
+
+//
+//
+
+RunCheckpoint::~RunCheckpoint()
+{
+  delete fBase;
+  delete fMessenger;
+}
+
+//
+//
+
+RunCheckpoint* RunCheckpoint::GetInstance()
+{
+  // Created on the master in main(); the workers only read the settings.
+  if (!theCheckpoint) {
+    theCheckpoint = new RunCheckpoint();
+  }
+  return theCheckpoint;
+}
+
+//
+//
+
+G4String RunCheckpoint::FileName(const G4String& name) const
+{
+  std::ostringstream fileName;
+  fileName << fDirectory << "/";
+#ifdef BF3_USE_MPI
+  // Every rank checkpoints and resumes its own share of the events.
+  fileName << "r" << G4MPImanager::GetManager()->GetRank() << "-";
+#endif
+  fileName << name;
+  return fileName.str();
+}
+
+//
+//
+
+G4String RunCheckpoint::BaseFileName(G4int generation) const
+{
+  std::ostringstream name;
+  name << "base-g" << generation << ".dat";
+  return FileName(name.str());
+}
+
+//
+//
+
+G4String RunCheckpoint::ThreadFilePrefix(G4int generation) const
+{
+  std::ostringstream name;
+  name << "ckpt-g" << generation << "-";
+  return FileName(name.str());
+}
+
+//
+//
+
+void RunCheckpoint::RemoveFiles(G4int generation) const
+{
+  // The files of one generation, or of all of them if negative.
+  std::vector<G4String> prefixes;
+  if (generation >= 0) {
+    prefixes.push_back(BaseFileName(generation));
+    prefixes.push_back(ThreadFilePrefix(generation));
+  } else {
+    prefixes.push_back(FileName("base-g"));
+    prefixes.push_back(FileName("ckpt-g"));
+    prefixes.push_back(FileName("state.txt"));
+  }
+  for (const auto& prefix : prefixes) {
+    G4String dir = prefix.substr(0, prefix.rfind('/'));
+    G4String start = prefix.substr(prefix.rfind('/') + 1);
+    for (const auto& name : ListFiles(dir, start)) {
+      std::remove((dir + "/" + name).c_str());
+    }
+  }
+}
+
+//
+//
+
+void RunCheckpoint::WriteState() const
+{
+  // Written last when a generation starts, this file is the commit point.
+  G4String fileName = FileName("state.txt");
+  G4String tmpName = fileName + ".tmp";
+  std::ofstream state(tmpName);
+  state << "total " << fTotalEvents << std::endl;
+  state << "generation " << fGeneration << std::endl;
+  state << "stream " << RandomStreams::GetInstance()->GetStreamID() << std::endl;
+  G4Random::getTheEngine()->put(state);
+  state.close();
+  if (!state || std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+    G4ExceptionDescription msg;
+    msg << "Cannot write the checkpoint state " << fileName << ".";
+    G4Exception("RunCheckpoint::WriteState()", "BF3Ckpt001", FatalException, msg);
+  }
+}
+
+//
+//
+
+G4bool RunCheckpoint::ReadState()
+{
+  std::ifstream state(FileName("state.txt"));
+  G4String word;
+  state >> word >> fTotalEvents;
+  if (!state || word != "total") return false;
+  state >> word >> fGeneration;
+  // The engine state that follows is a record only; the continued run is
+  // seeded from its stream ID.
+  return state && word == "generation";
+}
+
+//
+//
+
+void RunCheckpoint::Write(const Run* aRun) const
+{
+  std::ostringstream name;
+  name << ThreadFilePrefix(fGeneration) << "t" << std::max(G4Threading::G4GetThreadId(), 0) << ".dat";
+  RunFile::Header header;
+  header.setup = fSetup;
+  header.stream = RandomStreams::GetInstance()->GetStreamID();
+  if (!RunFile::Write(name.str(), aRun, header)) {
+    G4ExceptionDescription msg;
+    msg << "Cannot write the checkpoint " << name.str() << ", the run goes on.";
+    G4Exception("RunCheckpoint::Write()", "BF3Ckpt002", JustWarning, msg);
+  }
+}
+
+//
+//
+
+void RunCheckpoint::BeginRun(const G4Run* aRun)
+{
+  if (fDirectory.empty()) return;
+  fSetup = RunFile::GetSetup();
+  if (fResuming) {
+    // The state file commits the new generation, the old one can go.
+    WriteState();
+    RemoveFiles(fGeneration - 1);
+    return;
+  }
+  // A new run: forget any earlier checkpoints in the directory.
+  mkdir(fDirectory.c_str(), 0755);
+  RemoveFiles(-1);
+  delete fBase;
+  fBase = 0;
+  fGeneration = 0;
+  fTotalEvents = aRun->GetNumberOfEventToBeProcessed();
+  WriteState();
+}
+
+//
+//
+
+void RunCheckpoint::EndRun(Run* aRun)
+{
+  if (fDirectory.empty()) return;
+  if (fBase) {
+    aRun->Merge(fBase);
+    delete fBase;
+    fBase = 0;
+  }
+  fResuming = false;
+}
+
+//
+//
+
+void RunCheckpoint::Clear() const
+{
+  if (!fDirectory.empty()) RemoveFiles(-1);
+}
+
+//
+//
+
+void RunCheckpoint::Resume()
+{
+  if (fDirectory.empty() || !ReadState()) {
+    G4ExceptionDescription msg;
+    msg << "No checkpoint to resume in \"" << fDirectory << "\", set /BF3/run/checkpointDir.";
+    G4Exception("RunCheckpoint::Resume()", "BF3Ckpt003", JustWarning, msg);
+    return;
+  }
+  // Everything saved by the interrupted generation. Files of another
+  // setup would bias the result.
+  G4String setup = RunFile::GetSetup();
+  std::vector<G4String> files;
+  files.push_back(BaseFileName(fGeneration));
+  G4String prefix = ThreadFilePrefix(fGeneration);
+  G4String dir = prefix.substr(0, prefix.rfind('/'));
+  G4String start = prefix.substr(prefix.rfind('/') + 1);
+  for (const auto& name : ListFiles(dir, start)) {
+    if (name.size() < 4 || name.compare(name.size() - 4, 4, ".dat") != 0) continue;
+    files.push_back(dir + "/" + name);
+  }
+  Run* base = new Run();
+  for (const auto& file : files) {
+    Run saved;
+    RunFile::Header header;
+    // No base file in generation 0.
+    if (!RunFile::Read(file, &saved, header)) continue;
+    if (header.setup != setup) {
+      G4ExceptionDescription msg;
+      msg << "Checkpoint " << file << " is from another setup, skipped." << G4endl
+          << "  saved:   " << header.setup << G4endl
+          << "  current: " << setup;
+      G4Exception("RunCheckpoint::Resume()", "BF3Ckpt004", JustWarning, msg);
+      continue;
+    }
+    base->Merge(&saved);
+  }
+  G4double restored = base->GetNumberOfHistories();
+  G4int remaining = G4int(fTotalEvents - restored);
+  G4cout << "RunCheckpoint: " << restored << " of " << fTotalEvents
+         << " events restored from generation " << fGeneration << "." << G4endl;
+  if (remaining <= 0) {
+    G4cout << "RunCheckpoint: no events left to run." << G4endl;
+    delete base;
+    return;
+  }
+
+  // The base of the next generation; BeginRun commits it.
+  fGeneration++;
+  RunFile::Header header;
+  header.setup = setup;
+  header.stream = RandomStreams::GetInstance()->GetStreamID();
+  if (!RunFile::Write(BaseFileName(fGeneration), base, header)) {
+    G4ExceptionDescription msg;
+    msg << "Cannot write " << BaseFileName(fGeneration) << ".";
+    G4Exception("RunCheckpoint::Resume()", "BF3Ckpt001", FatalException, msg);
+  }
+
+  delete fBase;
+  fBase = base;
+  fResuming = true;
+  G4RunManager::GetRunManager()->BeamOn(remaining);
+  fResuming = false;
+}
@@ -0,0 +1,70 @@
+// Source code for RunCheckpointMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file RunCheckpointMessenger.cc
+/// \file Source code for RunCheckpointMessenger class.
+
+#include "RunCheckpoint.hh"
+#include "RunCheckpointMessenger.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+RunCheckpointMessenger::RunCheckpointMessenger(RunCheckpoint* myCheckpoint)
+: G4UImessenger(), fCheckpoint(myCheckpoint)
+{
+  fRunDir = new G4UIdirectory("/BF3/run/");
+  fRunDir->SetGuidance("Checkpoints of runs in progress.");
+
+  fDirectory = new G4UIcmdWithAString("/BF3/run/checkpointDir", this);
+  fDirectory->SetGuidance("Directory for the checkpoint files, e.g. on scratch.");
+  fDirectory->SetGuidance("An empty string turns checkpoints off.");
+  fDirectory->SetParameterName("dir", true);
+  fDirectory->SetDefaultValue("");
+  fDirectory->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fInterval = new G4UIcmdWithADoubleAndUnit("/BF3/run/checkpointInterval", this);
+  fInterval->SetGuidance("Wall clock time between the checkpoints of a thread.");
+  fInterval->SetParameterName("time", false);
+  fInterval->SetUnitCategory("Time");
+  fInterval->SetRange("time>0.");
+  fInterval->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fResume = new G4UIcmdWithoutParameter("/BF3/run/resume", this);
+  fResume->SetGuidance("Continue the run saved in the checkpoint directory: add up the");
+  fResume->SetGuidance("checkpoints and run the events still missing. Set up the job");
+  fResume->SetGuidance("as for the interrupted run and use this instead of /run/beamOn.");
+  fResume->AvailableForStates(G4State_Idle);
+
+  // The checkpoint settings are shared; only the master sets them.
+  fDirectory->SetToBeBroadcasted(false);
+  fInterval->SetToBeBroadcasted(false);
+  fResume->SetToBeBroadcasted(false);
+}
+
+//
+//
+
+RunCheckpointMessenger::~RunCheckpointMessenger()
+{
+  delete fDirectory;
+  delete fInterval;
+  delete fResume;
+  delete fRunDir;
+}
+
+//
+//
+
+void RunCheckpointMessenger::SetNewValue(G4UIcommand* command, G4String newVal)
+{
+  if (command == fDirectory) {
+    fCheckpoint->SetDirectory(newVal);
+  } else if (command == fInterval) {
+    fCheckpoint->SetInterval(fInterval->GetNewDoubleValue(newVal));
+  } else if (command == fResume) {
+    fCheckpoint->Resume();
+  }
+}
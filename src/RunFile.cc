@@ -0,0 +1,124 @@
+// Source code for RunFile().
+// Created by agent on October 17, 2026.
+
+/// \file RunFile.cc
+/// \brief Source code for RunFile class.
+
+#include "RunFile.hh"
+#include "Run.hh"
+#include "DetectorConstruction.hh"
+#include "PhysicsList.hh"
+
+#include "G4RunManager.hh"
+#include "G4Version.hh"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace {
+  const char kMagic[8] = {'B', 'F', '3', 'R', 'U', 'N', '0', '1'};
+  G4String thePhysicsSetup = "";
+
+  void WriteString(std::ofstream& out, const G4String& text)
+  {
+    std::uint32_t size = text.size();
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(text.data(), size);
+  }
+
+  G4bool ReadString(std::ifstream& in, G4String& text)
+  {
+    std::uint32_t size = 0;
+    in.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!in || size > 65536) return false;
+    std::vector<char> buffer(size);
+    in.read(buffer.data(), size);
+    text.assign(buffer.begin(), buffer.end());
+    return !in.fail();
+  }
+}
+
+void RunFile::SetPhysicsSetup(const G4String& setup)
+{
+  thePhysicsSetup = setup;
+}
+
+//
+//
+
+G4String RunFile::GetSetup()
+{
+  std::ostringstream setup;
+  setup << G4Version << " physics ";
+  const PhysicsList* physicsList = dynamic_cast<const PhysicsList*>(
+    G4RunManager::GetRunManager()->GetUserPhysicsList());
+  if (physicsList) setup << physicsList->GetMode() << " ";
+  setup << thePhysicsSetup;
+  const DetectorConstruction* detector = dynamic_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  if (detector) setup << " detector " << detector->GetSetupDescription();
+  return setup.str();
+}
+
+//
+//
+
+G4bool RunFile::Write(const G4String& fileName, const Run* aRun, const Header& header)
+{
+  // A merged copy flushes the tallies, the run itself may keep going.
+  Run copy;
+  copy.Merge(aRun);
+  std::vector<std::pair<G4double*, G4int> > blocks;
+  copy.GetBlocks(blocks);
+  G4double numbers[3] = {copy.GetNumberOfHistories(), header.runTime, 0.};
+  for (const auto& block : blocks) numbers[2] += block.second;
+
+  G4String tmpName = fileName + ".tmp";
+  std::ofstream out(tmpName, std::ios::binary);
+  out.write(kMagic, sizeof(kMagic));
+  WriteString(out, header.setup);
+  WriteString(out, header.stream);
+  out.write(reinterpret_cast<const char*>(numbers), sizeof(numbers));
+  for (const auto& block : blocks) {
+    out.write(reinterpret_cast<const char*>(block.first), block.second*sizeof(G4double));
+  }
+  out.close();
+  return out && std::rename(tmpName.c_str(), fileName.c_str()) == 0;
+}
+
+//
+//
+
+G4bool RunFile::Read(const G4String& fileName, Run* aRun, Header& header)
+{
+  std::ifstream in(fileName, std::ios::binary);
+  char magic[sizeof(kMagic)];
+  in.read(magic, sizeof(magic));
+  if (!in || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) return false;
+  if (!ReadString(in, header.setup) || !ReadString(in, header.stream)) return false;
+  G4double numbers[3];
+  in.read(reinterpret_cast<char*>(numbers), sizeof(numbers));
+  if (!in) return false;
+  header.runTime = numbers[1];
+
+  Run saved;
+  std::vector<std::pair<G4double*, G4int> > blocks;
+  saved.GetBlocks(blocks);
+  G4double size = 0.;
+  for (const auto& block : blocks) size += block.second;
+  // Written with a different binning.
+  if (size != numbers[2]) return false;
+  for (const auto& block : blocks) {
+    in.read(reinterpret_cast<char*>(block.first), block.second*sizeof(G4double));
+  }
+  if (!in) return false;
+  // The event count numbers[0] is also in the convergence sums, see
+  // Run::GetNumberOfHistories.
+  aRun->Merge(&saved);
+  return true;
+}
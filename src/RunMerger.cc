@@ -0,0 +1,59 @@
+// Source code for RunMerger().
+// Created by agent on October 17, 2026.
+
+/// \file RunMerger.cc
+/// \brief Source code for RunMerger class.
+
+#ifdef BF3_USE_MPI
+
+#include "RunMerger.hh"
+#include "Run.hh"
+
+#include "G4MPImanager.hh"
+
+#include <vector>
+
+RunMerger::RunMerger(const Run* aRun)
+: G4VUserMPIrunMerger(aRun, G4MPImanager::kRANK_MASTER), fRun(aRun), fCopy(0)
+{}
+
+//
+//
+
+RunMerger::~RunMerger()
+{
+  delete fCopy;
+}
+
+//
+//
+
+void RunMerger::Pack()
+{
+  // The run to send is const; a merged copy flushes the tallies and gets
+  // the padded convergence history.
+  delete fCopy;
+  fCopy = new Run();
+  fCopy->Merge(fRun);
+  std::vector<std::pair<G4double*, G4int> > blocks;
+  fCopy->GetBlocks(blocks);
+  for (const auto& block : blocks) {
+    InputUserData(block.first, MPI_DOUBLE, block.second);
+  }
+}
+
+//
+//
+
+G4Run* RunMerger::UnPack()
+{
+  Run* aRun = new Run();
+  std::vector<std::pair<G4double*, G4int> > blocks;
+  aRun->GetBlocks(blocks);
+  for (const auto& block : blocks) {
+    OutputUserData(block.first, MPI_DOUBLE, block.second);
+  }
+  return aRun;
+}
+
+#endif
@@ -0,0 +1,143 @@
+// Source code for StackingAction().
+// Created by agent on October 17, 2026.
+
+/// \file StackingAction.cc
+/// \brief Source code for StackingAction class.
+
+#include "StackingAction.hh"
+#include "StackingMessenger.hh"
+#include "DetectorConstruction.hh"
+#include "Run.hh"
+
+#include "G4RunManager.hh"
+#include "G4Track.hh"
+#include "G4Neutron.hh"
+#include "G4NistManager.hh"
+#include "G4EmCalculator.hh"
+#include "G4ProcessTable.hh"
+#include "G4NeutronKiller.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+StackingAction::StackingAction()
+: G4UserStackingAction(), fKillEM(true), fKillRemote(true),
+  fNeutronTimeLimit(DBL_MAX), fNeutronEnergyLimit(0.), fRun(0)
+{
+  fDetector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  fAir = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+  fCalculator = new G4EmCalculator();
+  fMessenger = new StackingMessenger(this);
+}
+
+//
+//
+
+StackingAction::~StackingAction()
+{
+  delete fMessenger;
+  delete fCalculator;
+}
+
+//
+//
+
+void StackingAction::PrepareNewEvent()
+{
+  fRun = static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+}
+
+//
+//
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  const G4ParticleDefinition* particle = track->GetDefinition();
+  G4double ekin = track->GetKineticEnergy();
+  G4int code = particle->GetPDGEncoding();
+
+  if (particle == G4Neutron::Definition()) {
+    if (track->GetGlobalTime() > fNeutronTimeLimit) {
+      fRun->CountKill(Run::kKillNeutronTime, ekin);
+      return fKill;
+    }
+    if (ekin < fNeutronEnergyLimit) {
+      fRun->CountKill(Run::kKillNeutronEnergy, ekin);
+      return fKill;
+    }
+    return fUrgent;
+  }
+
+  // Primaries are always kept.
+  if (track->GetParentID() == 0) return fUrgent;
+
+  if (fKillEM && (code == 22 || code == 11 || code == -11)) {
+    fRun->CountKill(Run::kKillEM, ekin);
+    return fKill;
+  }
+
+  if (fKillRemote && particle->GetPDGCharge() != 0. && particle->GetBaryonNumber() > 0) {
+    G4double distance = DistanceToGas(track->GetPosition());
+    if (distance > 0.) {
+      // The restricted range is longer than the CSDA range.
+      G4double range = fCalculator->GetRangeFromRestricteDEDX(ekin, particle, fAir);
+      if (range > 0. && range < distance) {
+        fRun->CountKill(Run::kKillIon, ekin);
+        return fKill;
+      }
+    }
+  }
+  return fUrgent;
+}
+
+//
+//
+
+G4double StackingAction::DistanceToGas(const G4ThreeVector& pos) const
+{
+  // Distance to the closer of the two gas cylinders, 0 inside.
+  G4double radius = 0.5*fDetector->GetTubeDiameter();
+  G4double halfZ = 0.5*fDetector->GetTubeHeight();
+  G4double offset = fDetector->GetTubeOffset();
+  G4double dz = std::max(std::abs(pos.z()) - halfZ, 0.);
+  G4double distance = DBL_MAX;
+  for (G4double x0 : {offset, -offset}) {
+    G4double dr = std::max(std::hypot(pos.x() - x0, pos.y()) - radius, 0.);
+    distance = std::min(distance, std::hypot(dr, dz));
+  }
+  return distance;
+}
+
+//
+//
+
+void StackingAction::SetNeutronTimeLimit(G4double value)
+{
+  fNeutronTimeLimit = value;
+  UpdateNeutronKiller();
+}
+
+//
+//
+
+void StackingAction::SetNeutronEnergyLimit(G4double value)
+{
+  fNeutronEnergyLimit = value;
+  UpdateNeutronKiller();
+}
+
+//
+//
+
+void StackingAction::UpdateNeutronKiller() const
+{
+  // The process of this thread, registered by G4NeutronTrackingCut.
+  G4NeutronKiller* killer = dynamic_cast<G4NeutronKiller*>(
+    G4ProcessTable::GetProcessTable()->FindProcess("nKiller", G4Neutron::Definition()));
+  if (killer) {
+    killer->SetTimeLimit(fNeutronTimeLimit);
+    killer->SetKinEnergyLimit(fNeutronEnergyLimit);
+  }
+}
@@ -0,0 +1,74 @@
+// Source code for StackingMessenger().
+// Created by agent on October 17, 2026.
+
+/// \file StackingMessenger.cc
+/// \file Source code for StackingMessenger class.
+
+#include "StackingAction.hh"
+#include "StackingMessenger.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+
+StackingMessenger::StackingMessenger(StackingAction* myStackingAction)
+: G4UImessenger(), fStackingAction(myStackingAction)
+{
+  fStackDir = new G4UIdirectory("/BF3/stack/");
+  fStackDir->SetGuidance("Removal of tracks that cannot reach the tube tallies.");
+
+  fKillEM = new G4UIcmdWithABool("/BF3/stack/killElectromagnetic", this);
+  fKillEM->SetGuidance("Kill secondary gammas, electrons and positrons; they are not");
+  fKillEM->SetGuidance("scored by the tubes.");
+  fKillEM->SetParameterName("flag", false);
+  fKillEM->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fKillRemote = new G4UIcmdWithABool("/BF3/stack/killRemoteCharged", this);
+  fKillRemote->SetGuidance("Kill secondary protons and ions farther from the gas than");
+  fKillRemote->SetGuidance("their range in air.");
+  fKillRemote->SetParameterName("flag", false);
+  fKillRemote->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fTimeLimit = new G4UIcmdWithADoubleAndUnit("/BF3/stack/neutronTimeLimit", this);
+  fTimeLimit->SetGuidance("Kill neutrons after this global time (new and in flight).");
+  fTimeLimit->SetParameterName("time", false);
+  fTimeLimit->SetUnitCategory("Time");
+  fTimeLimit->SetRange("time>0.");
+  fTimeLimit->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fEnergyLimit = new G4UIcmdWithADoubleAndUnit("/BF3/stack/neutronEnergyLimit", this);
+  fEnergyLimit->SetGuidance("Kill neutrons below this kinetic energy (new and in flight).");
+  fEnergyLimit->SetGuidance("Thermal neutrons make the signal, use with care.");
+  fEnergyLimit->SetParameterName("energy", false);
+  fEnergyLimit->SetUnitCategory("Energy");
+  fEnergyLimit->SetRange("energy>=0.");
+  fEnergyLimit->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//
+//
+
+StackingMessenger::~StackingMessenger()
+{
+  delete fKillEM;
+  delete fKillRemote;
+  delete fTimeLimit;
+  delete fEnergyLimit;
+  delete fStackDir;
+}
+
+//
+//
+
+void StackingMessenger::SetNewValue(G4UIcommand* command, G4String newVal)
+{
+  if (command == fKillEM) {
+    fStackingAction->SetKillElectromagnetic(fKillEM->GetNewBoolValue(newVal));
+  } else if (command == fKillRemote) {
+    fStackingAction->SetKillRemoteCharged(fKillRemote->GetNewBoolValue(newVal));
+  } else if (command == fTimeLimit) {
+    fStackingAction->SetNeutronTimeLimit(fTimeLimit->GetNewDoubleValue(newVal));
+  } else if (command == fEnergyLimit) {
+    fStackingAction->SetNeutronEnergyLimit(fEnergyLimit->GetNewDoubleValue(newVal));
+  }
+}
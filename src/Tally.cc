@@ -0,0 +1,259 @@
+// Source code for Tally1D() and Tally2D().
+// Created by agent on October 17, 2026.
+
+/// \file Tally.cc
+/// \brief Source code for the Tally1D and Tally2D classes.
+
+#include "Tally.hh"
+
+#include <tools/histo/h1d>
+#include <tools/histo/h2d>
+
+#include <cfloat>
+
+Tally1D::Tally1D(G4int nbins, G4double xmin, G4double xmax)
+: fNbins(nbins), fFixed(true), fXmin(xmin), fInvWidth(nbins/(xmax - xmin)),
+  fSearchSize(0), fNPending(0)
+{
+  Reset();
+}
+
+//
+//
+
+Tally1D::Tally1D(const std::vector<G4double>& edges)
+: fNbins(G4int(edges.size()) - 1), fFixed(false), fXmin(edges.front()), fInvWidth(0.),
+  fNPending(0)
+{
+  fSearchSize = 1;
+  while (fSearchSize < edges.size()) fSearchSize *= 2;
+  fEdges.assign(fSearchSize, DBL_MAX);
+  std::copy(edges.begin(), edges.end(), fEdges.begin());
+  Reset();
+}
+
+//
+//
+
+Tally1D::~Tally1D()
+{}
+
+//
+//
+
+void Tally1D::Reset()
+{
+  fEntries.assign(fNbins + 2, 0.);
+  fSw.assign(fNbins + 2, 0.);
+  fSw2.assign(fNbins + 2, 0.);
+  fSxw.assign(fNbins + 2, 0.);
+  fSx2w.assign(fNbins + 2, 0.);
+  fNPending = 0;
+}
+
+//
+//
+
+G4int Tally1D::FindBin(G4double x) const
+{
+  if (fFixed) {
+    G4double t = (x - fXmin)*fInvWidth;
+    if (!(t >= 0.)) return 0;
+    if (t >= fNbins) return fNbins + 1;
+    return G4int(t) + 1;
+  }
+  if (!(x >= fEdges[0])) return 0;
+  // Branch-free lower bound: largest pos with fEdges[pos] <= x.
+  size_t pos = 0;
+  for (size_t step = fSearchSize/2; step > 0; step /= 2) {
+    pos += (fEdges[pos + step] <= x) ? step : 0;
+  }
+  return (G4int(pos) < fNbins) ? G4int(pos) + 1 : fNbins + 1;
+}
+
+//
+//
+
+void Tally1D::Flush() const
+{
+  // Bin the whole batch first so the index loop stays free of scatters.
+  for (size_t i = 0; i < fNPending; i++) {
+    fPendingBin[i] = FindBin(fPendingX[i]);
+  }
+  Tally1D* self = const_cast<Tally1D*>(this);
+  for (size_t i = 0; i < fNPending; i++) {
+    G4int bin = fPendingBin[i];
+    G4double x = fPendingX[i];
+    G4double w = fPendingW[i];
+    self->fEntries[bin] += 1.;
+    self->fSw[bin] += w;
+    self->fSw2[bin] += w*w;
+    self->fSxw[bin] += w*x;
+    self->fSx2w[bin] += w*x*x;
+  }
+  fNPending = 0;
+}
+
+//
+//
+
+void Tally1D::Merge(const Tally1D& other)
+{
+  Flush();
+  other.Flush();
+  for (G4int i = 0; i < fNbins + 2; i++) {
+    fEntries[i] += other.fEntries[i];
+    fSw[i] += other.fSw[i];
+    fSw2[i] += other.fSw2[i];
+    fSxw[i] += other.fSxw[i];
+    fSx2w[i] += other.fSx2w[i];
+  }
+}
+
+//
+//
+
+void Tally1D::GetBlocks(std::vector<std::pair<G4double*, G4int> >& blocks)
+{
+  Flush();
+  G4int n = fNbins + 2;
+  blocks.push_back(std::make_pair(fEntries.data(), n));
+  blocks.push_back(std::make_pair(fSw.data(), n));
+  blocks.push_back(std::make_pair(fSw2.data(), n));
+  blocks.push_back(std::make_pair(fSxw.data(), n));
+  blocks.push_back(std::make_pair(fSx2w.data(), n));
+}
+
+//
+//
+
+G4double Tally1D::GetSumW() const
+{
+  Flush();
+  G4double sum = 0.;
+  for (G4int i = 0; i < fNbins + 2; i++) sum += fSw[i];
+  return sum;
+}
+
+//
+//
+
+void Tally1D::AddTo(tools::histo::h1d* histo) const
+{
+  Flush();
+  tools::histo::h1d::hd_t data = histo->get_histo_data();
+  for (G4int i = 0; i < fNbins + 2; i++) {
+    data.m_bin_entries[i] += (unsigned int)fEntries[i];
+    data.m_bin_Sw[i] += fSw[i];
+    data.m_bin_Sw2[i] += fSw2[i];
+    data.m_bin_Sxw[i][0] += fSxw[i];
+    data.m_bin_Sx2w[i][0] += fSx2w[i];
+  }
+  histo->copy_from_data(data);
+}
+
+//
+//
+
+Tally2D::Tally2D(G4int nx, G4double xmin, G4double xmax, G4int ny, G4double ymin, G4double ymax)
+: fNx(nx), fNy(ny), fXmin(xmin), fYmin(ymin),
+  fInvWidthX(nx/(xmax - xmin)), fInvWidthY(ny/(ymax - ymin))
+{
+  Reset();
+}
+
+//
+//
+
+Tally2D::~Tally2D()
+{}
+
+//
+//
+
+void Tally2D::Reset()
+{
+  size_t n = (fNx + 2)*(fNy + 2);
+  fEntries.assign(n, 0.);
+  fSw.assign(n, 0.);
+  fSw2.assign(n, 0.);
+  fSxw.assign(n, 0.);
+  fSx2w.assign(n, 0.);
+  fSyw.assign(n, 0.);
+  fSy2w.assign(n, 0.);
+}
+
+//
+//
+
+G4int Tally2D::Index(G4double v, G4double vmin, G4double invWidth, G4int n) const
+{
+  G4double t = (v - vmin)*invWidth;
+  if (!(t >= 0.)) return 0;
+  if (t >= n) return n + 1;
+  return G4int(t) + 1;
+}
+
+//
+//
+
+void Tally2D::Fill(G4double x, G4double y, G4double w)
+{
+  size_t i = Index(x, fXmin, fInvWidthX, fNx) + (fNx + 2)*Index(y, fYmin, fInvWidthY, fNy);
+  fEntries[i] += 1.;
+  fSw[i] += w;
+  fSw2[i] += w*w;
+  fSxw[i] += w*x;
+  fSx2w[i] += w*x*x;
+  fSyw[i] += w*y;
+  fSy2w[i] += w*y*y;
+}
+
+//
+//
+
+void Tally2D::Merge(const Tally2D& other)
+{
+  for (size_t i = 0; i < fSw.size(); i++) {
+    fEntries[i] += other.fEntries[i];
+    fSw[i] += other.fSw[i];
+    fSw2[i] += other.fSw2[i];
+    fSxw[i] += other.fSxw[i];
+    fSx2w[i] += other.fSx2w[i];
+    fSyw[i] += other.fSyw[i];
+    fSy2w[i] += other.fSy2w[i];
+  }
+}
+
+//
+//
+
+void Tally2D::GetBlocks(std::vector<std::pair<G4double*, G4int> >& blocks)
+{
+  G4int n = G4int(fSw.size());
+  blocks.push_back(std::make_pair(fEntries.data(), n));
+  blocks.push_back(std::make_pair(fSw.data(), n));
+  blocks.push_back(std::make_pair(fSw2.data(), n));
+  blocks.push_back(std::make_pair(fSxw.data(), n));
+  blocks.push_back(std::make_pair(fSx2w.data(), n));
+  blocks.push_back(std::make_pair(fSyw.data(), n));
+  blocks.push_back(std::make_pair(fSy2w.data(), n));
+}
+
+//
+//
+
+void Tally2D::AddTo(tools::histo::h2d* histo) const
+{
+  tools::histo::h2d::hd_t data = histo->get_histo_data();
+  for (size_t i = 0; i < fSw.size(); i++) {
+    data.m_bin_entries[i] += (unsigned int)fEntries[i];
+    data.m_bin_Sw[i] += fSw[i];
+    data.m_bin_Sw2[i] += fSw2[i];
+    data.m_bin_Sxw[i][0] += fSxw[i];
+    data.m_bin_Sx2w[i][0] += fSx2w[i];
+    data.m_bin_Sxw[i][1] += fSyw[i];
+    data.m_bin_Sx2w[i][1] += fSy2w[i];
+  }
+  histo->copy_from_data(data);
+}
@@ -0,0 +1,37 @@
+// Source code for TrackingAction().
+// Created by agent on October 17, 2026.
+
+/// \file TrackingAction.cc
+/// \brief Source code for TrackingAction class.
+
+#include "TrackingAction.hh"
+#include "Run.hh"
+
+#include "G4RunManager.hh"
+#include "G4Track.hh"
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4VProcess.hh"
+#include "G4Neutron.hh"
+
+TrackingAction::TrackingAction() : G4UserTrackingAction()
+{}
+
+//
+//
+
+TrackingAction::~TrackingAction()
+{}
+
+//
+//
+
+void TrackingAction::PostUserTrackingAction(const G4Track* track)
+{
+  if (track->GetDefinition() != G4Neutron::Definition()) return;
+  const G4VProcess* process = track->GetStep()->GetPostStepPoint()->GetProcessDefinedStep();
+  if (process && process->GetProcessName() == "nKiller") {
+    Run* run = static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+    run->CountKill(Run::kKillNeutronInFlight, track->GetKineticEnergy());
+  }
+}
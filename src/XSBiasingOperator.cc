@@ -0,0 +1,95 @@
+// Source code for XSBiasingOperator().
+// Created by agent on October 17, 2026.
+// Adapted from the Geant4 example GB01.
+
+/// \file XSBiasingOperator.cc
+/// \brief Source code for XSBiasingOperator class.
+
+#include "XSBiasingOperator.hh"
+
+#include "G4BiasingProcessInterface.hh"
+#include "G4BiasingProcessSharedData.hh"
+#include "G4BOptnChangeCrossSection.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4ProcessManager.hh"
+#include "G4VProcess.hh"
+#include "G4Track.hh"
+
+#include <cfloat>
+
+XSBiasingOperator::XSBiasingOperator(const G4String& particleToBias, G4double factor, const G4String& name)
+: G4VBiasingOperator(name), fSetup(false), fFactor(factor)
+{
+  fParticleToBias = G4ParticleTable::GetParticleTable()->FindParticle(particleToBias);
+  if (!fParticleToBias) {
+    G4Exception("XSBiasingOperator::XSBiasingOperator()", "BF3XS001", FatalException,
+                ("Particle " + particleToBias + " not found.").c_str());
+  }
+}
+
+//
+//
+
+XSBiasingOperator::~XSBiasingOperator()
+{
+  for (auto itr = fChangeCrossSectionOperations.begin(); itr != fChangeCrossSectionOperations.end(); itr++) {
+    delete itr->second;
+  }
+}
+
+//
+//
+
+void XSBiasingOperator::StartRun()
+{
+  // One operation per biased process, created once per thread.
+  if (fSetup) return;
+  const G4ProcessManager* processManager = fParticleToBias->GetProcessManager();
+  const G4BiasingProcessSharedData* sharedData = G4BiasingProcessInterface::GetSharedData(processManager);
+  if (sharedData) {
+    for (size_t i = 0; i < (sharedData->GetPhysicsBiasingProcessInterfaces()).size(); i++) {
+      const G4BiasingProcessInterface* wrapperProcess = (sharedData->GetPhysicsBiasingProcessInterfaces())[i];
+      G4String operationName = "XSchange-" + wrapperProcess->GetWrappedProcess()->GetProcessName();
+      fChangeCrossSectionOperations[wrapperProcess] = new G4BOptnChangeCrossSection(operationName);
+    }
+  }
+  fSetup = true;
+}
+
+//
+//
+
+G4VBiasingOperation* XSBiasingOperator::ProposeOccurenceBiasingOperation(const G4Track* track, const G4BiasingProcessInterface* callingProcess)
+{
+  if (track->GetDefinition() != fParticleToBias) return 0;
+
+  G4double analogInteractionLength = callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+  if (analogInteractionLength > DBL_MAX/10.) return 0;
+  G4double analogXS = 1./analogInteractionLength;
+
+  G4BOptnChangeCrossSection* operation = fChangeCrossSectionOperations[callingProcess];
+  G4VBiasingOperation* previousOperation = callingProcess->GetPreviousOccurenceBiasingOperation();
+  if (previousOperation == 0 || operation->GetInteractionOccured()) {
+    operation->SetBiasedCrossSection(fFactor*analogXS);
+    operation->Sample();
+  } else {
+    // Same operation as on the previous step: move the sampled interaction
+    // point by the step taken, then apply the (possibly new) cross section.
+    operation->UpdateForStep(callingProcess->GetPreviousStepSize());
+    operation->SetBiasedCrossSection(fFactor*analogXS);
+    operation->UpdateForStep(0.0);
+  }
+  return operation;
+}
+
+//
+//
+
+void XSBiasingOperator::OperationApplied(const G4BiasingProcessInterface* callingProcess, G4BiasingAppliedCase,
+                                         G4VBiasingOperation* occurenceOperationApplied, G4double,
+                                         G4VBiasingOperation*, const G4VParticleChange*)
+{
+  G4BOptnChangeCrossSection* operation = fChangeCrossSectionOperations[callingProcess];
+  if (operation == occurenceOperationApplied) operation->SetInteractionOccured();
+}
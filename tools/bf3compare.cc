@@ -0,0 +1,87 @@
+// Comparison of two BF3 results.
+// Created by agent on October 17, 2026.
+
+/// \file bf3compare.cc
+/// \brief Check that two -tally.dat files agree within their errors.
+//
+// Usage: bf3-compare [-z 3] reference-tally.dat result-tally.dat
+//
+// Compares the weighted mean deposit per history of each tube and of both,
+// and the weighted detections per history (see Run), of two results. A
+// value differs when |a - b| > z*sqrt(da^2 + db^2), da and db being the
+// standard errors of the means. Biased runs (energy, cross-section or
+// importance biasing) score weighted histories, so they estimate the same
+// means as an analog run of the same source and must agree with it. The
+// setups may differ, that is the point; the source may not. Values that
+// one of the runs does not score are skipped. The exit code is 1 if any
+// value differs.
+
+#include "ConvergenceStats.hh"
+#include "Run.hh"
+#include "RunFile.hh"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+  // Returns true if both means agree within z standard deviations.
+  bool Compare(const std::string& name, const ConvergenceStats& a, const ConvergenceStats& b,
+               double z)
+  {
+    if (a.GetHistories() == 0. || b.GetHistories() == 0.) {
+      std::cout << name << ": not scored, skipped." << std::endl;
+      return true;
+    }
+    double errA = a.GetMean()*a.GetRelativeError();
+    double errB = b.GetMean()*b.GetRelativeError();
+    double sigma = std::sqrt(errA*errA + errB*errB);
+    double diff = b.GetMean() - a.GetMean();
+    bool agree = std::abs(diff) <= z*sigma;
+    std::cout << name << ": " << a.GetMean() << " +- " << errA << " and "
+              << b.GetMean() << " +- " << errB << ", difference "
+              << ((sigma > 0.) ? diff/sigma : 0.) << " sigma" << (agree ? "" : ", DIFFERENT")
+              << std::endl;
+    return agree;
+  }
+
+}
+
+int main(int argc, char** argv)
+{
+  double z = 3.;
+  std::string names[2];
+  int nNames = 0;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-z" && i + 1 < argc) {
+      z = std::atof(argv[++i]);
+    } else if (nNames < 2) {
+      names[nNames++] = arg;
+    }
+  }
+  if (nNames != 2 || z <= 0.) {
+    std::cerr << "Usage: bf3-compare [-z 3] reference-tally.dat result-tally.dat" << std::endl;
+    return 2;
+  }
+
+  Run runs[2];
+  for (int i = 0; i < 2; i++) {
+    RunFile::Header header;
+    if (!RunFile::Read(names[i], &runs[i], header)) {
+      std::cerr << names[i] << ": not a tally file of this build." << std::endl;
+      return 2;
+    }
+    std::cout << names[i] << ": " << runs[i].GetNumberOfHistories() << " events, setup "
+              << header.setup << std::endl;
+  }
+
+  bool agree = Compare("BF3EnergyDep1", runs[0].GetConvergence1(), runs[1].GetConvergence1(), z);
+  agree = Compare("BF3EnergyDep2", runs[0].GetConvergence2(), runs[1].GetConvergence2(), z) && agree;
+  agree = Compare("BF3EnergyDepTot", runs[0].GetConvergenceTot(), runs[1].GetConvergenceTot(), z) && agree;
+  agree = Compare("BF3Detected", runs[0].GetDetected(), runs[1].GetDetected(), z) && agree;
+  std::cout << (agree ? "Results agree" : "Results differ") << " within " << z << " sigma." << std::endl;
+  return agree ? 0 : 1;
+}
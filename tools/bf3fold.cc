@@ -0,0 +1,255 @@
+// Offline spectrum folding for the BF3 response matrix.
+// Created by agent on October 17, 2026.
+
+/// \file bf3fold.cc
+/// \brief Fold a /gps/hist/point source spectrum with a stored response matrix.
+//
+// Usage: bf3-fold [-d direction] [-s sourceRate] [-t tolerance] [-o output] matrix.txt spectrum.mac
+//
+// matrix.txt is written by /BF3/sweep/run. spectrum.mac is any macro with
+// /gps/hist/point lines (e.g. bugle96.mac): the first point is the lower
+// edge, every following point (E, w) is a group from the previous energy to
+// E holding probability w, sampled flat in energy as GPS does.
+// Responses are averaged over all directions unless -d picks one.
+// Spectrum weight outside the matrix energy range is dropped (group-wise
+// matrix) or given the response of the nearest energy (monoenergetic
+// matrix); the fraction is reported, and above -t (default 0.01) the
+// folding is refused.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+  struct Cell {
+    double energy, eLow, eHigh, theta, phi, events, eff, effErr;
+    std::vector<double> phs;
+    std::vector<double> phsErr;
+  };
+
+  struct Matrix {
+    size_t nEnergies = 0;
+    size_t nDirections = 0;
+    size_t nBins = 0;
+    double phsMin = 0.;
+    double phsMax = 0.;
+    std::vector<Cell> cells; // energy major, direction minor
+  };
+
+  void ReadValues(std::istringstream& is, std::vector<double>& values)
+  {
+    double v;
+    while (is >> v) values.push_back(v);
+  }
+
+  bool ReadMatrix(const std::string& fileName, Matrix& matrix)
+  {
+    std::ifstream in(fileName);
+    if (!in) return false;
+    std::string line;
+    bool haveHeader = false;
+    while (std::getline(in, line)) {
+      if (line.empty() || line[0] == '#') continue;
+      std::istringstream is(line);
+      if (!haveHeader) {
+        is >> matrix.nEnergies >> matrix.nDirections >> matrix.nBins >> matrix.phsMin >> matrix.phsMax;
+        haveHeader = true;
+        continue;
+      }
+      std::string key;
+      is >> key;
+      if (key == "cell") {
+        Cell cell;
+        is >> cell.energy >> cell.eLow >> cell.eHigh >> cell.theta >> cell.phi
+           >> cell.events >> cell.eff >> cell.effErr;
+        matrix.cells.push_back(cell);
+      } else if (key == "phs" && !matrix.cells.empty()) {
+        ReadValues(is, matrix.cells.back().phs);
+      } else if (key == "phsErr" && !matrix.cells.empty()) {
+        ReadValues(is, matrix.cells.back().phsErr);
+      }
+    }
+    return haveHeader && matrix.cells.size() == matrix.nEnergies*matrix.nDirections;
+  }
+
+  bool ReadSpectrum(const std::string& fileName, std::vector<double>& energies, std::vector<double>& weights)
+  {
+    std::ifstream in(fileName);
+    if (!in) return false;
+    std::string line;
+    while (std::getline(in, line)) {
+      std::istringstream is(line);
+      std::string command;
+      double e, w;
+      if (!(is >> command) || command != "/gps/hist/point") continue;
+      if (!(is >> e >> w)) continue;
+      energies.push_back(e);
+      weights.push_back(w);
+    }
+    return energies.size() >= 2;
+  }
+
+  // Fraction of the flat spectrum group [lo, hi] falling into [a, b].
+  double Overlap(double lo, double hi, double a, double b)
+  {
+    double width = hi - lo;
+    if (width <= 0.) return (lo >= a && lo < b) ? 1. : 0.;
+    double l = std::max(lo, a);
+    double h = std::min(hi, b);
+    return (h > l) ? (h - l)/width : 0.;
+  }
+
+  // Coefficients of every matrix energy row for one spectrum group.
+  // Returns the fraction of the group inside the matrix energy range.
+  double GroupCoefficients(const Matrix& matrix, double lo, double hi, std::vector<double>& coeff)
+  {
+    std::fill(coeff.begin(), coeff.end(), 0.);
+    size_t nE = matrix.nEnergies;
+    const Cell& first = matrix.cells[0];
+    if (first.eHigh > first.eLow) {
+      // Group-wise response: flat inside every matrix group.
+      double covered = 0.;
+      for (size_t i = 0; i < nE; i++) {
+        const Cell& c = matrix.cells[i*matrix.nDirections];
+        coeff[i] = Overlap(lo, hi, c.eLow, c.eHigh);
+        covered += coeff[i];
+      }
+      return covered;
+    }
+    double covered = Overlap(lo, hi, first.energy, matrix.cells[(nE - 1)*matrix.nDirections].energy);
+    // Monoenergetic response: interpolate linearly in log(E) at the
+    // logarithmic mid-point of the spectrum group, constant outside.
+    double e = (lo > 0.) ? std::sqrt(lo*hi) : hi;
+    double x = std::log(e);
+    for (size_t i = 0; i + 1 < nE; i++) {
+      double e0 = matrix.cells[i*matrix.nDirections].energy;
+      double e1 = matrix.cells[(i + 1)*matrix.nDirections].energy;
+      if (e >= e0 && e < e1) {
+        double t = (x - std::log(e0))/(std::log(e1) - std::log(e0));
+        coeff[i] = 1. - t;
+        coeff[i + 1] = t;
+        return covered;
+      }
+    }
+    if (e < matrix.cells[0].energy) coeff[0] = 1.;
+    else coeff[nE - 1] = 1.;
+    return covered;
+  }
+
+  void Usage()
+  {
+    std::cerr << "Usage: bf3-fold [-d direction] [-s sourceRate] [-t tolerance] [-o output] matrix.txt spectrum.mac" << std::endl;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int direction = -1;
+  double sourceRate = 1.;
+  double tolerance = 0.01;
+  std::string outName;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-d" && i + 1 < argc) direction = std::atoi(argv[++i]);
+    else if (arg == "-s" && i + 1 < argc) sourceRate = std::atof(argv[++i]);
+    else if (arg == "-t" && i + 1 < argc) tolerance = std::atof(argv[++i]);
+    else if (arg == "-o" && i + 1 < argc) outName = argv[++i];
+    else files.push_back(arg);
+  }
+  if (files.size() != 2) {
+    Usage();
+    return 1;
+  }
+
+  Matrix matrix;
+  if (!ReadMatrix(files[0], matrix)) {
+    std::cerr << "bf3-fold: cannot read response matrix " << files[0] << std::endl;
+    return 1;
+  }
+  if (direction >= int(matrix.nDirections)) {
+    std::cerr << "bf3-fold: matrix has only " << matrix.nDirections << " directions" << std::endl;
+    return 1;
+  }
+  std::vector<double> energies, weights;
+  if (!ReadSpectrum(files[1], energies, weights)) {
+    std::cerr << "bf3-fold: no /gps/hist/point spectrum in " << files[1] << std::endl;
+    return 1;
+  }
+
+  // Collect one coefficient per matrix cell, so correlated use of the same
+  // cell by several spectrum groups is propagated correctly.
+  double norm = 0.;
+  for (size_t i = 1; i < weights.size(); i++) norm += weights[i];
+  if (norm <= 0.) {
+    std::cerr << "bf3-fold: spectrum has no weight" << std::endl;
+    return 1;
+  }
+  std::vector<double> rowCoeff(matrix.nEnergies, 0.);
+  std::vector<double> groupCoeff(matrix.nEnergies, 0.);
+  double uncovered = 0.;
+  for (size_t i = 1; i < energies.size(); i++) {
+    if (weights[i] <= 0.) continue;
+    double covered = GroupCoefficients(matrix, energies[i - 1], energies[i], groupCoeff);
+    uncovered += weights[i]/norm*std::max(1. - covered, 0.);
+    for (size_t j = 0; j < matrix.nEnergies; j++) {
+      rowCoeff[j] += weights[i]/norm*groupCoeff[j];
+    }
+  }
+  // Rounding of the group edges in the matrix file is not a gap.
+  if (uncovered < 1.e-9) uncovered = 0.;
+  if (uncovered > 0.) {
+    std::cerr << "bf3-fold: " << uncovered << " of the spectrum weight is outside the matrix energy range "
+              << ((matrix.cells[0].eHigh > matrix.cells[0].eLow) ? "and dropped" : "and extrapolated")
+              << std::endl;
+  }
+  if (uncovered > tolerance) {
+    std::cerr << "bf3-fold: more than the tolerance " << tolerance << ", extend the matrix or raise -t" << std::endl;
+    return 1;
+  }
+  std::vector<double> cellCoeff(matrix.cells.size(), 0.);
+  for (size_t j = 0; j < matrix.nEnergies; j++) {
+    for (size_t k = 0; k < matrix.nDirections; k++) {
+      if (direction >= 0 && int(k) != direction) continue;
+      double share = (direction >= 0) ? 1. : 1./matrix.nDirections;
+      cellCoeff[j*matrix.nDirections + k] = rowCoeff[j]*share;
+    }
+  }
+
+  double eff = 0., effVar = 0.;
+  std::vector<double> phs(matrix.nBins, 0.), phsVar(matrix.nBins, 0.);
+  for (size_t c = 0; c < matrix.cells.size(); c++) {
+    double a = cellCoeff[c];
+    if (a == 0.) continue;
+    const Cell& cell = matrix.cells[c];
+    eff += a*cell.eff;
+    effVar += a*a*cell.effErr*cell.effErr;
+    for (size_t b = 0; b < matrix.nBins && b < cell.phs.size(); b++) {
+      phs[b] += a*cell.phs[b];
+      if (b < cell.phsErr.size()) phsVar[b] += a*a*cell.phsErr[b]*cell.phsErr[b];
+    }
+  }
+
+  std::ofstream outFile;
+  if (!outName.empty()) outFile.open(outName);
+  std::ostream& out = outName.empty() ? std::cout : outFile;
+  out << std::setprecision(8);
+  out << "# bf3-fold " << files[0] << " " << files[1] << std::endl;
+  out << "# spectrum weight outside the matrix energy range: " << uncovered << std::endl;
+  out << "efficiency " << eff << " " << std::sqrt(effVar) << std::endl;
+  out << "countRate " << eff*sourceRate << " " << std::sqrt(effVar)*sourceRate << std::endl;
+  out << "# bin lowEdge[MeV] highEdge[MeV] counts/source error" << std::endl;
+  double width = (matrix.phsMax - matrix.phsMin)/matrix.nBins;
+  for (size_t b = 0; b < matrix.nBins; b++) {
+    out << b + 1 << " " << matrix.phsMin + b*width << " " << matrix.phsMin + (b + 1)*width
+        << " " << phs[b]*sourceRate << " " << std::sqrt(phsVar[b])*sourceRate << std::endl;
+  }
+  return 0;
+}
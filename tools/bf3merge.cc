@@ -0,0 +1,121 @@
+// Merge of partial BF3 results.
+// Created by agent on October 17, 2026.
+
+/// \file bf3merge.cc
+/// \brief Add up the -tally.dat files of many jobs into one result.
+//
+// Usage: bf3-merge [-o BF3Merged.root] [-list files.txt] result-tally.dat...
+//
+// Every bf3 run writes its raw sums next to the ROOT file (see RunFile):
+// bin contents, sums of weights and squared weights, convergence moments
+// and the event count. Adding them gives exactly the event-weighted
+// combination of the runs, including the convergence statistics, which
+// cannot be recovered from the histograms or -conv.txt files. The inputs
+// are read one at a time, so memory does not grow with their number;
+// -list reads the input names from a file, one per line, for job arrays
+// too large for the command line. Inputs whose setup (Geant4 version,
+// physics options, detector design) differs from the first one, or whose
+// random stream was already merged, are refused. The output is a ROOT
+// file with the histograms of Analysis::Book, its -conv.txt file and a
+// -tally.dat file, so merged results can be merged again.
+
+#include "Analysis.hh"
+#include "Run.hh"
+#include "RunFile.hh"
+
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+
+namespace {
+
+  struct Merger {
+    Run total;
+    RunFile::Header first;
+    std::set<std::string> streams;
+    G4double runTime = 0.;
+    size_t nMerged = 0;
+    size_t nRefused = 0;
+
+    void Add(const std::string& fileName)
+    {
+      Run part;
+      RunFile::Header header;
+      if (!RunFile::Read(fileName, &part, header)) {
+        std::cerr << fileName << ": not a tally file of this build, refused." << std::endl;
+        nRefused++;
+        return;
+      }
+      if (nMerged == 0) {
+        first = header;
+      } else if (header.setup != first.setup) {
+        std::cerr << fileName << ": different setup, refused." << std::endl
+                  << "  " << header.setup << std::endl
+                  << "  expected " << first.setup << std::endl;
+        nRefused++;
+        return;
+      }
+      if (!streams.insert(header.stream).second) {
+        std::cerr << fileName << ": random stream \"" << header.stream
+                  << "\" already merged, refused." << std::endl;
+        nRefused++;
+        return;
+      }
+      total.Merge(&part);
+      runTime += header.runTime;
+      nMerged++;
+    }
+  };
+
+}
+
+int main(int argc, char** argv)
+{
+  std::string outName = "BF3Merged.root";
+  Merger merger;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "-o" && i + 1 < argc) {
+      outName = argv[++i];
+    } else if (arg == "-list" && i + 1 < argc) {
+      std::ifstream list(argv[++i]);
+      if (!list) {
+        std::cerr << "Cannot read " << argv[i] << std::endl;
+        return 1;
+      }
+      std::string line;
+      while (std::getline(list, line)) {
+        if (!line.empty() && line[0] != '#') merger.Add(line);
+      }
+    } else {
+      merger.Add(arg);
+    }
+  }
+  if (merger.nMerged == 0) {
+    std::cerr << "Usage: bf3-merge [-o BF3Merged.root] [-list files.txt] result-tally.dat..." << std::endl;
+    return 1;
+  }
+
+  std::ostringstream stream;
+  stream << "merged " << merger.nMerged << " results";
+  Analysis* analysis = Analysis::GetAnalysis();
+  analysis->Book(outName, "setup: " + merger.first.setup + " | stream: " + stream.str());
+  analysis->OpenFile(outName);
+  analysis->WriteTallies(&merger.total);
+  analysis->Save();
+  analysis->Close();
+  // The FOM uses the summed run time of all inputs.
+  analysis->CheckConvergence(&merger.total, merger.runTime);
+
+  RunFile::Header header;
+  header.setup = merger.first.setup;
+  header.stream = stream.str();
+  header.runTime = merger.runTime;
+  RunFile::Write(outName + "-tally.dat", &merger.total, header);
+
+  std::cout << "Merged " << merger.nMerged << " results, " << merger.total.GetNumberOfHistories()
+            << " events, into " << outName << "; " << merger.nRefused << " refused." << std::endl;
+  return merger.nRefused == 0 ? 0 : 1;
+}